@@ -0,0 +1,194 @@
+// ׼ԣ̶sorted/reverse/uniform/zipfָأ
+// ÿμʱÿһJSON׼ڽűԱȻع
+//
+
+#include "benchmark.h"
+
+#include "tree.h"
+#include "node_allocator.h"
+
+#include <vector>
+#include <algorithm>
+#include <random>
+
+const char* kModule = "binary_search_tree";
+
+// ʱ˻ݹʵֵȺͺʱO(N)ָصĹģ
+const int kDegenerateMaxNum = 5000;
+
+template<typename TTree>
+void RunReadOps(const char* tree_name, const char* workload, const TTree& tree, const std::vector<int>& probes, int n)
+{
+	LatencyRecorder recorder(static_cast<int>(probes.size()));
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Get(key) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Get", n);
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Rank(key)); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Rank", n);
+
+	const int size = tree.Size();
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Select(key % size + 1) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Select", n);
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Floor(key) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Floor", n);
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Ceiling(key) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Ceiling", n);
+
+	for (size_t i = 0; i < probes.size(); i++)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Min() != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Min", n);
+
+	for (size_t i = 0; i < probes.size(); i++)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Max() != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Max", n);
+}
+
+// дϣдһPutһDeleteĹģ²
+template<typename TTree>
+void RunMixedOps(const char* tree_name, const char* workload, const char* op, int read_percent, TTree& tree, const std::vector<int>& probes, int n, uint64_t seed)
+{
+	LatencyRecorder recorder(static_cast<int>(probes.size()));
+	std::mt19937_64 engine(seed);
+
+	bool put_next = true;
+	for (int key : probes)
+	{
+		if (static_cast<int>(engine() % 100) < read_percent)
+		{
+			recorder.Measure([&]() { DoNotOptimize(tree.Get(key) != nullptr); });
+			continue;
+		}
+
+		int write_key = key & ~1;
+		if (put_next)
+		{
+			recorder.Measure([&]() { tree.Put(write_key); });
+		}
+		else
+		{
+			recorder.Measure([&]() { tree.Delete(write_key); });
+		}
+		put_next = !put_next;
+	}
+	recorder.Report(kModule, tree_name, workload, op, n);
+}
+
+template<typename TTree>
+void RunWorkload(const char* tree_name, KeyOrder order, const BenchConfig& config)
+{
+	const char* workload = KeyOrderName(order);
+	const bool degenerate = order == KeyOrder::kSorted || order == KeyOrder::kReverse;
+	const int n = degenerate ? std::min(config.n, kDegenerateMaxNum) : config.n;
+
+	auto keys = MakeKeys(order, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(order, config.ops, n, config.theta, config.seed + 1);
+
+	TTree tree;
+	LatencyRecorder recorder(std::max(n, config.ops));
+
+	for (int key : keys)
+	{
+		recorder.Measure([&]() { tree.Put(key); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Put", n);
+
+	RunReadOps(tree_name, workload, tree, probes, n);
+
+	RunMixedOps(tree_name, workload, "Mixed95", 95, tree, probes, n, config.seed + 2);
+	RunMixedOps(tree_name, workload, "Mixed50", 50, tree, probes, n, config.seed + 3);
+
+	for (int key : keys)
+	{
+		recorder.Measure([&]() { tree.Delete(key); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Delete", n);
+
+	std::vector<int> sorted_keys(keys);
+	std::sort(sorted_keys.begin(), sorted_keys.end());
+	sorted_keys.erase(std::unique(sorted_keys.begin(), sorted_keys.end()), sorted_keys.end());
+
+	recorder.MeasureBatch(static_cast<int>(sorted_keys.size()), [&]() { tree.BuildFromSorted(sorted_keys.begin(), sorted_keys.end()); });
+	recorder.Report(kModule, tree_name, workload, "BuildFromSorted", n);
+
+	const int half = tree.Size() / 2;
+	for (int i = 0; i < half; i++)
+	{
+		recorder.Measure([&]() { tree.DelMin(); });
+	}
+	recorder.Report(kModule, tree_name, workload, "DelMin", n);
+
+	while (tree.Size() > 0)
+	{
+		recorder.Measure([&]() { tree.DelMax(); });
+	}
+	recorder.Report(kModule, tree_name, workload, "DelMax", n);
+}
+
+// ĹӳɾBinarySearchTreeͬ
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator>
+class LazyDeleteTree :public BinarySearchTree<T, TAllocator>
+{
+public:
+	LazyDeleteTree()
+	{
+		this->SetLazyDelete(true);
+	}
+};
+
+// ģʽҲܱO(logN)
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator>
+class ScapegoatTree :public BinarySearchTree<T, TAllocator>
+{
+public:
+	ScapegoatTree()
+	{
+		this->SetScapegoat(true);
+	}
+};
+
+template<typename TTree>
+void RunAllWorkloads(const char* tree_name, const BenchConfig& config)
+{
+	RunWorkload<TTree>(tree_name, KeyOrder::kSorted, config);
+	RunWorkload<TTree>(tree_name, KeyOrder::kReverse, config);
+	RunWorkload<TTree>(tree_name, KeyOrder::kUniform, config);
+	RunWorkload<TTree>(tree_name, KeyOrder::kZipf, config);
+}
+
+int main(int argc, char* argv[])
+{
+	BenchConfig config;
+	if (!config.Parse(argc, argv))
+	{
+		return 1;
+	}
+
+	RunAllWorkloads<BinarySearchTree<int>>("BinarySearchTree", config);
+	RunAllWorkloads<BinarySearchTree<int, PoolNodeAllocator>>("BinarySearchTree<Pool>", config);
+	RunAllWorkloads<LazyDeleteTree<int>>("BinarySearchTree<Lazy>", config);
+	RunAllWorkloads<ScapegoatTree<int>>("BinarySearchTree<Scapegoat>", config);
+
+	return 0;
+}
@@ -1,5 +1,6 @@
 #include "tree.h"
 #include "node.h"
+#include "tree_file.h"
 
 #include <iostream>
 #include <vector>
@@ -244,6 +245,189 @@ private:
 	std::time_t update_time_;
 };
 
+// дļֱO(N)ؽֱӳѯ
+void TestTreeFile(int num, const char* path)
+{
+	PrintFormat("TestTreeFile");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 10);
+
+	std::vector<int> vals;
+	for (int i = 0; i < num; i++)
+	{
+		vals.push_back(uniform_dist(e1));
+	}
+
+	BinarySearchTree<int> bst;
+	for (int val : vals)
+	{
+		bst.Put(val);
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	if (!SaveTreeFile(bst, path))
+	{
+		std::cout << "save failed" << std::endl;
+		return;
+	}
+	auto save_end = std::chrono::steady_clock::now();
+
+	BinarySearchTree<int> loaded_bst;
+	bool load_ok = LoadTreeFile(loaded_bst, path);
+	auto load_end = std::chrono::steady_clock::now();
+
+	MappedTree<int> mapped;
+	bool open_ok = mapped.Open(path);
+
+	int mismatch_num = 0;
+	for (int i = 0; i < num; i += 101)
+	{
+		if (mapped.Rank(vals[i]) != bst.Rank(vals[i]))
+		{
+			++mismatch_num;
+		}
+	}
+
+	std::cout << "size:" << bst.Size() << " height:" << bst.Height() << " load:" << load_ok << " loaded height:" << loaded_bst.Height()
+		<< " open:" << open_ok << " mapped size:" << mapped.Size() << " rank mismatch:" << mismatch_num << std::endl;
+	std::cout << "save us:" << std::chrono::duration_cast<std::chrono::microseconds>(save_end - begin).count()
+		<< " load us:" << std::chrono::duration_cast<std::chrono::microseconds>(load_end - save_end).count() << std::endl;
+
+	mapped.Close();
+	std::remove(path);
+}
+
+// ɾܼʱԱHibbardɾĹӳɾ
+void TestLazyDelete(int num)
+{
+	PrintFormat("TestLazyDelete");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 10);
+
+	std::vector<int> vals;
+	for (int i = 0; i < num; i++)
+	{
+		vals.push_back(uniform_dist(e1));
+	}
+
+	for (int lazy = 0; lazy < 2; ++lazy)
+	{
+		BinarySearchTree<int> bst;
+		bst.SetLazyDelete(lazy != 0);
+		for (int val : vals)
+		{
+			bst.Put(val);
+		}
+
+		auto begin = std::chrono::steady_clock::now();
+		// ɾͲ뽻棬ɾļһֱ
+		for (int i = 0; i < num; i++)
+		{
+			bst.Delete(vals[i]);
+			if (i % 3 == 0)
+			{
+				bst.Put(vals[i / 2]);
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		std::cout << (lazy ? "lazy" : "hibbard") << " size:" << bst.Size() << " dead:" << bst.DeadNum() << " height:" << bst.Height()
+			<< " us:" << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << std::endl;
+
+		bst.SetLazyDelete(false);
+		std::cout << "after purge size:" << bst.Size() << " dead:" << bst.DeadNum() << " height:" << bst.Height() << std::endl;
+	}
+}
+
+// ʱԱͨģʽģʽ
+void TestScapegoat(int num, int degenerate_num)
+{
+	PrintFormat("TestScapegoat");
+
+	// ͨģʽ˻ݹO(N)ģ̫
+	BinarySearchTree<int> plain_bst;
+	for (int i = 0; i < degenerate_num; i++)
+	{
+		plain_bst.Put(i);
+	}
+
+	BinarySearchTree<int> bst;
+	bst.SetScapegoat(true);
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < num; i++)
+	{
+		bst.Put(i);
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	std::cout << "plain size:" << plain_bst.Size() << " height:" << plain_bst.Height() << std::endl;
+	std::cout << "scapegoat size:" << bst.Size() << " height:" << bst.Height() << " rank:" << bst.Rank(num / 2)
+		<< " us:" << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << std::endl;
+
+	for (int i = 0; i < num; i += 2)
+	{
+		bst.Delete(i);
+	}
+	std::cout << "after delete size:" << bst.Size() << " height:" << bst.Height() << std::endl;
+}
+
+void TestCloneAndMove(int num, int thread_num)
+{
+	PrintFormat("TestCloneAndMove");
+
+	BinarySearchTree<int> bst;
+	bst.SetScapegoat(true);
+	bst.SetLazyDelete(true);
+	for (int i = 0; i < num; i++)
+	{
+		bst.Put(i);
+	}
+	for (int i = 0; i < num; i += 3)
+	{
+		bst.Delete(i);
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	BinarySearchTree<int> copy = bst.Clone(thread_num);
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "clone size:" << copy.Size() << " dead:" << copy.DeadNum() << " height:" << copy.Height()
+		<< " us:" << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << std::endl;
+
+	// ԭӰ
+	copy.Delete(1);
+	std::cout << "after delete in copy, bst size:" << bst.Size() << " copy size:" << copy.Size() << std::endl;
+
+	BinarySearchTree<int> moved(std::move(copy));
+	BinarySearchTree<int> other;
+	other.Put(-1);
+	moved.Swap(other);
+	std::cout << "moved size:" << moved.Size() << " other size:" << other.Size() << " source size:" << copy.Size() << std::endl;
+}
+
+void TestMultiset(int num, int distinct_num)
+{
+	PrintFormat("TestMultiset");
+
+	BinarySearchTree<int> bst;
+	bst.SetMultiset(true);
+	bst.SetScapegoat(true);
+	for (int i = 0; i < num; i++)
+	{
+		bst.Put(rand() % distinct_num);
+	}
+	int mid = bst.Select(bst.Size() / 2)->val;
+	std::cout << "size:" << bst.Size() << " height:" << bst.Height() << " median:" << mid
+		<< " count:" << bst.Count(mid) << " rank:" << bst.Rank(mid) << std::endl;
+
+	bst.Delete(mid);
+	std::cout << "after delete, count:" << bst.Count(mid) << " size:" << bst.Size() << std::endl;
+
+	bst.SetMultiset(false);
+	std::cout << "set mode size:" << bst.Size() << " count:" << bst.Count(mid) << std::endl;
+}
+
 int main()
 {
 	{
@@ -261,6 +445,21 @@ int main()
 		bst.Delete(del_val);
 		TestHeight(bst);
 	}
+	{
+		TestTreeFile(100000, "binary_search_tree.tree");
+	}
+	{
+		TestLazyDelete(100000);
+	}
+	{
+		TestScapegoat(1000000, 5000);
+	}
+	{
+		TestCloneAndMove(1000000, 4);
+	}
+	{
+		TestMultiset(1000000, 1000);
+	}
 	//{
 	//	BinarySearchTree<int> bst;
 	//	bst.Put(10);
@@ -1,11 +1,15 @@
 #ifndef NODE_H_
 #define NODE_H_
 
+#include "node_allocator.h"
+
 #include <memory>
 
-template<typename T>
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator>
 struct Node
 {
+	using UniqueNodeType = std::unique_ptr<Node, typename TAllocator<Node>::Deleter>;
+
 	Node() = delete;
 	Node(const Node&) = delete;
 	Node& operator=(const Node&) = delete;
@@ -15,8 +19,8 @@ struct Node
 	{
 	}
 
-	std::unique_ptr<Node<T>> left;
-	std::unique_ptr<Node<T>> right;
+	UniqueNodeType left;
+	UniqueNodeType right;
 
 	T val;
 
@@ -7,26 +7,101 @@
 #include <functional>
 #include <vector>
 #include <stack>
-
-template<typename T>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <thread>
+
+// ԿĹģʽSetLazyDeleteɾֻǣĹʱؽ
+// ڵ㲻ɾǣsub_node_numֻͳδɾĽڵ㣬
+// ֮ʱڵ㱾Ĺ
+// ҲԿģʽSetScapegoatʱؽʧڵṹ䡣
+// ؼģʽSetMultisetͬļʽвĲǽڵĹΪ0
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator>
 class BinarySearchTree
 {
 public:
 	using RealTType = std::remove_reference_t<std::decay_t<T>>;
-	using NodeType = Node<RealTType>;
-	using UniqueNodeType = std::unique_ptr<NodeType>;
+	using NodeType = Node<RealTType, TAllocator>;
+	using UniqueNodeType = typename NodeType::UniqueNodeType;
+	using AllocatorType = TAllocator<NodeType>;
 
 	BinarySearchTree() :root_(nullptr)
 	{
 	}
 
-	~BinarySearchTree() = default;
+	explicit BinarySearchTree(const AllocatorType& alloc) :alloc_(alloc), root_(nullptr)
+	{
+	}
+
+	~BinarySearchTree()
+	{
+		alloc_.Release(std::move(root_));
+	}
 
 	BinarySearchTree(const BinarySearchTree&) = delete;
 	BinarySearchTree& operator=(const BinarySearchTree&) = delete;
 
-	BinarySearchTree(BinarySearchTree&&) = delete;
-	BinarySearchTree& operator=(BinarySearchTree&&) = delete;
+	// ƶָֻ롢ģʽãӶO(1)
+	// ƶһµķΪԿɼʹ
+	BinarySearchTree(BinarySearchTree&& other) :root_(nullptr)
+	{
+		Swap(other);
+	}
+
+	BinarySearchTree& operator=(BinarySearchTree&& other)
+	{
+		if (&other != this)
+		{
+			BinarySearchTree temp(std::move(other));
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	void Swap(BinarySearchTree& other)noexcept
+	{
+		std::swap(alloc_, other.alloc_);
+		root_.swap(other.root_);
+		std::swap(lazy_delete_, other.lazy_delete_);
+		std::swap(max_dead_ratio_, other.max_dead_ratio_);
+		std::swap(dead_num_, other.dead_num_);
+		std::swap(scapegoat_, other.scapegoat_);
+		std::swap(scapegoat_alpha_, other.scapegoat_alpha_);
+		std::swap(max_node_num_, other.max_node_num_);
+		std::swap(multiset_, other.multiset_);
+	}
+
+	// ṹƳһĹͼԭȽϣӶO(N)ʹµķ
+	// thread_num1ʱΪ0ʱȡӲ߳ǰĴ̸߳ƣ̸߳һµķ
+	// ֻĽڵɸķͷʱHeapNodeAllocatorŲ
+	BinarySearchTree Clone(int thread_num = 1)const
+	{
+		BinarySearchTree result;
+		result.lazy_delete_ = lazy_delete_;
+		result.max_dead_ratio_ = max_dead_ratio_;
+		result.dead_num_ = dead_num_;
+		result.scapegoat_ = scapegoat_;
+		result.scapegoat_alpha_ = scapegoat_alpha_;
+		result.max_node_num_ = max_node_num_;
+		result.multiset_ = multiset_;
+
+		int parallel_depth = 0;
+		if (result.alloc_ == AllocatorType())
+		{
+			if (thread_num <= 0)
+			{
+				thread_num = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+			}
+			while ((1 << parallel_depth) < thread_num)
+			{
+				++parallel_depth;
+			}
+		}
+
+		result.root_ = Clone(root_.get(), result.alloc_, parallel_depth);
+		return result;
+	}
 
 public:
 
@@ -40,13 +115,20 @@ public:
 	>
 	void Put(NodeValType&& val)
 	{
+		if (scapegoat_)
+		{
+			ScapegoatPut(std::forward<NodeValType>(val));
+			return;
+		}
+
 		root_ = Put(std::move(root_), std::forward<NodeValType>(val));
 	}
 
 	template<typename NodeValType>
 	NodeType const*const Get(NodeValType&& val) const noexcept
 	{
-		return Get(root_.get(), std::forward<NodeValType>(val));
+		NodeType const*const node = Get(root_.get(), std::forward<NodeValType>(val));
+		return node != nullptr && IsAlive(node) ? node : nullptr;
 	}
 
 	const int Height()const noexcept
@@ -66,30 +148,161 @@ public:
 		return Ceiling(root_.get(), std::forward<NodeValType>(val));
 	}
 
+	// ĹʱҵĽڵɾΪȡ
 	NodeType const*const Min()const noexcept
 	{
-		return Min(root_.get());
+		return dead_num_ == 0 ? Min(root_.get()) : Select(1);
 	}
 
 	NodeType const*const Max()const noexcept
 	{
-		return Max(root_.get());
+		return dead_num_ == 0 ? Max(root_.get()) : Select(Size());
 	}
 
 	void DelMin()
 	{
+		if (lazy_delete_)
+		{
+			if (Size() > 0)
+			{
+				LazyDelete(Min()->val);
+			}
+			return;
+		}
+
 		root_ = DelMin(std::move(root_));
+		CheckShrink();
 	}
 
 	void DelMax()
 	{
+		if (lazy_delete_)
+		{
+			if (Size() > 0)
+			{
+				LazyDelete(Max()->val);
+			}
+			return;
+		}
+
 		root_ = DelMax(std::move(root_));
+		CheckShrink();
 	}
 
 	template<typename NodeValType>
 	void Delete(NodeValType&& val)
 	{
+		if (lazy_delete_)
+		{
+			LazyDelete(val);
+			return;
+		}
+
 		root_ = Delete(std::move(root_),std::forward<NodeValType>(val));
+		CheckShrink();
+	}
+
+	// ĹģʽDeleteDelMinDelMaxֻѽڵΪɾѲ·ϵļ1ṹ
+	// PutֵͬĹʱֱӸøýڵ㡣Ĺռȫڵımax_dead_ratioʱ
+	// O(N)ڰѴĽڵؽȫƽͷĹÿؽĿ̯֮ǰɾϡ
+	// رĹģʽʱеĹ
+	void SetLazyDelete(bool enable, double max_dead_ratio = 0.25)
+	{
+		lazy_delete_ = enable;
+		max_dead_ratio_ = max_dead_ratio;
+		if (!lazy_delete_ && dead_num_ > 0)
+		{
+			Rebuild();
+		}
+	}
+
+	const bool IsLazyDelete()const noexcept
+	{
+		return lazy_delete_;
+	}
+
+	// Ĺĸ
+	const int DeadNum()const noexcept
+	{
+		return dead_num_;
+	}
+
+	// ͷĹѴĽڵ㰴ؽȫƽڵֱӸ
+	void Rebuild()
+	{
+		root_ = Rebuild(std::move(root_));
+		max_node_num_ = Size();
+	}
+
+	// ģʽPutز·룬½ڵȳlog(1/alpha)(N)ʱ
+	// ¶ҵһ Size(ӽڵ) > alpha * Size(ڵ) ȣO(size)ؽȫƽ
+	// ɾڵʷֵalphaʱؽһΣʹʼO(logN)
+	// alphaȡ(0.5, 1)ԽСԽؽԽƵʱȰؽһ
+	void SetScapegoat(bool enable, double alpha = 0.7)
+	{
+		scapegoat_ = enable;
+		scapegoat_alpha_ = alpha;
+		if (scapegoat_)
+		{
+			Rebuild();
+		}
+	}
+
+	const bool IsScapegoat()const noexcept
+	{
+		return scapegoat_;
+	}
+
+	// ؼģʽPutȵֵʱٺԣֻѸýڵ1DeleteDelMinDelMaxڻظʱֻ1
+	// ֻز·ҲͷŽڵ㡣SizeRankSelectÿֵֻһΣCountȡá
+	// Ĺģʽ0ĽڵĹرʱظԪغϲΪһͬʱĹӶO(N)
+	void SetMultiset(bool enable)
+	{
+		multiset_ = enable;
+		if (multiset_ || root_ == nullptr)
+		{
+			return;
+		}
+
+		std::vector<UniqueNodeType> nodes;
+		nodes.reserve(Size());
+		Flatten(std::move(root_), nodes);
+
+		auto node_it = nodes.begin();
+		auto make = [&node_it]()
+		{
+			UniqueNodeType node = std::move(*node_it);
+			node->sub_node_num = 1;
+			++node_it;
+			return node;
+		};
+		root_ = Build(make, static_cast<int>(nodes.size()));
+		max_node_num_ = Size();
+	}
+
+	const bool IsMultiset()const noexcept
+	{
+		return multiset_;
+	}
+
+	// valʱΪ0ǶؼģʽʱΪ1
+	template<typename NodeValType>
+	const int Count(const NodeValType& val)const noexcept
+	{
+		NodeType const*const node = Get(root_.get(), val);
+		return node == nullptr ? 0 : OwnNum(node);
+	}
+
+	// ڵǷѱɾ
+	static const bool IsDeleted(const NodeType* node)noexcept
+	{
+		return !IsAlive(node);
+	}
+
+	// ڵĹΪ0ڵⲿ루SaveTreeFileʹ
+	static const int OwnNum(const NodeType* node)noexcept
+	{
+		return node->sub_node_num - Size(node->left.get()) - Size(node->right.get());
 	}
 
 	NodeType const*const Select(int ranking)const noexcept
@@ -135,6 +348,73 @@ public:
 		return Size(root_.get());
 	}
 
+	// ϸO(N)ؽȫƽԭݻᱻա
+	// ؼģʽֻǵݼȵһκϲһڵ
+	template<typename TIterator>
+	void BuildFromSorted(TIterator first, TIterator last)
+	{
+		Clear();
+
+		int num = 0;
+		if (multiset_)
+		{
+			for (TIterator it = first; it != last; ++num)
+			{
+				TIterator prev = it;
+				while (++it != last && !(*prev < *it))
+				{
+				}
+			}
+		}
+		else
+		{
+			num = static_cast<int>(std::distance(first, last));
+		}
+
+		auto make = [this, &first, &last]()
+		{
+			UniqueNodeType node = alloc_.New(*first);
+			++first;
+			while (multiset_ && first != last && !(node->val < *first))
+			{
+				++node->sub_node_num;
+				++first;
+			}
+			return node;
+		};
+		root_ = Build(make, num);
+		max_node_num_ = Size();
+	}
+
+	// ȥؽؼģʽ²ȥ
+	template<typename TIterator>
+	void BuildFromUnsorted(TIterator first, TIterator last)
+	{
+		std::vector<RealTType> vals(first, last);
+		std::sort(vals.begin(), vals.end());
+		if (!multiset_)
+		{
+			vals.erase(std::unique(vals.begin(), vals.end(), [](const RealTType& l, const RealTType& r)
+			{
+				return !(l < r) && !(r < l);
+			}), vals.end());
+		}
+
+		BuildFromSorted(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+	}
+
+	void Clear()
+	{
+		alloc_.Free(std::move(root_));
+		dead_num_ = 0;
+		max_node_num_ = 0;
+	}
+
+	const AllocatorType& GetAllocator()const noexcept
+	{
+		return alloc_;
+	}
+
 private:
 
 	template<typename NodeValType>
@@ -142,9 +422,11 @@ private:
 	{
 		if (node == nullptr)
 		{
-			return std::make_unique<NodeType>(std::forward<NodeValType>(param));
+			return alloc_.New(std::forward<NodeValType>(param));
 		}
 
+		// ıǰȡڵĹΪ0
+		int num = OwnNum(node.get());
 		if (param < node->val)
 		{
 			node->left = Put(std::move(node->left), std::forward<NodeValType>(param));
@@ -153,8 +435,18 @@ private:
 		{
 			node->right = Put(std::move(node->right), std::forward<NodeValType>(param));
 		}
+		else if (num == 0)
+		{
+			node->val = std::forward<NodeValType>(param);
+			num = 1;
+			--dead_num_;
+		}
+		else if (multiset_)
+		{
+			++num;
+		}
 
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + num;
 
 		return node;
 	}
@@ -209,7 +501,8 @@ private:
 		auto tmp = Floor(node->right.get(), std::forward<NodeValType>(val));
 		if (tmp == nullptr)
 		{
-			return node;
+			// ڵĹʱȡĴڵ
+			return IsAlive(node) ? node : Select(node->left.get(), Size(node->left.get()));
 		}
 		
 		return tmp;
@@ -231,7 +524,8 @@ private:
 		auto tmp = Ceiling(node->left.get(), std::forward<NodeValType>(val));
 		if (tmp == nullptr)
 		{
-			return node;
+			// ڵĹʱȡСĴڵ
+			return IsAlive(node) ? node : Select(node->right.get(), 1);
 		}
 
 		return tmp;
@@ -269,20 +563,21 @@ private:
 		return max_node;
 	}
 
-	UniqueNodeType RemoveMin(NodeType* node)
+	// nodeΪеСڵժأСڵӻԭλãժµĽڵļֻʣ
+	UniqueNodeType RemoveMin(UniqueNodeType& node)
 	{
-		if (node == nullptr)
-		{
-			return nullptr;
-		}
-		if (node->left->left == nullptr)
+		if (node->left == nullptr)
 		{
-			auto left = std::move(node->left);
-			node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
-			return left;
+			UniqueNodeType min_node = std::move(node);
+			node = std::move(min_node->right);
+			min_node->sub_node_num -= Size(node.get());
+			return min_node;
 		}
 
-		return RemoveMin(node->left.get());
+		UniqueNodeType min_node = RemoveMin(node->left);
+		node->sub_node_num -= min_node->sub_node_num;
+
+		return min_node;
 	}
 
 	UniqueNodeType DelMin(UniqueNodeType node)
@@ -294,12 +589,22 @@ private:
 
 		if (node->left == nullptr)
 		{
-			return std::move(node->right);
+			// ظʱֻ
+			if (OwnNum(node.get()) > 1)
+			{
+				--node->sub_node_num;
+				return node;
+			}
+
+			UniqueNodeType right = std::move(node->right);
+			alloc_.Free(std::move(node));
+			return right;
 		}
 
+		const int num = OwnNum(node.get());
 		node->left = DelMin(std::move(node->left));
 
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + num;
 
 		return node;
 	}
@@ -313,12 +618,21 @@ private:
 
 		if (node->right == nullptr)
 		{
-			return std::move(node->left);
+			if (OwnNum(node.get()) > 1)
+			{
+				--node->sub_node_num;
+				return node;
+			}
+
+			UniqueNodeType left = std::move(node->left);
+			alloc_.Free(std::move(node));
+			return left;
 		}
 
+		const int num = OwnNum(node.get());
 		node->right = DelMax(std::move(node->right));
 
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + num;
 
 		return node;
 	}
@@ -330,6 +644,8 @@ private:
 		{
 			return nullptr;
 		}
+
+		int num = OwnNum(node.get());
 		if (val < node->val)
 		{
 			node->left = Delete(std::move(node->left), std::forward<NodeValType>(val));
@@ -338,33 +654,35 @@ private:
 		{
 			node->right = Delete(std::move(node->right), std::forward<NodeValType>(val));
 		}
+		else if (num > 1)
+		{
+			// ظʱֻ
+			--num;
+		}
 		else
 		{
 			if (node->left == nullptr)
 			{
-				return std::move(node->right);
+				UniqueNodeType right = std::move(node->right);
+				alloc_.Free(std::move(node));
+				return right;
 			}
 			if (node->right == nullptr)
 			{
-				return std::move(node->left);
+				UniqueNodeType left = std::move(node->left);
+				alloc_.Free(std::move(node));
+				return left;
 			}
 
-			UniqueNodeType left = std::move(node->left);
-			if (node->right->left == nullptr)
-			{
-				node = std::move(node->right);
-				node->left = std::move(left);
-			}
-			else
-			{
-				UniqueNodeType tmp = std::move(node);
-				node = RemoveMin(tmp->right.get());
-				node->left = std::move(left);
-				node->right = std::move(tmp->right);
-			}
+			UniqueNodeType tmp = std::move(node);
+			node = RemoveMin(tmp->right);
+			num = node->sub_node_num;
+			node->left = std::move(tmp->left);
+			node->right = std::move(tmp->right);
+			alloc_.Free(std::move(tmp));
 		}
 
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + num;
 
 		return node;
 	}
@@ -376,12 +694,15 @@ private:
 			return nullptr;
 		}
 
-		int num = Size(node->left.get()) + 1;
-		if (num > ranking)
+		const int left_num = Size(node->left.get());
+		if (left_num >= ranking)
 		{
 			return Select(node->left.get(), ranking);
 		}
-		else if (num < ranking)
+
+		// ռĹռ
+		int num = left_num + OwnNum(node);
+		if (num < ranking)
 		{
 			return Select(node->right.get(), ranking - num);
 		}
@@ -407,10 +728,10 @@ private:
 			{
 				return rank;
 			}
-			return 1 + Size(node->left.get()) + rank;
+			return OwnNum(node) + Size(node->left.get()) + rank;
 		}
 
-		return Size(node->left.get()) + 1;
+		return IsAlive(node) ? Size(node->left.get()) + 1 : 0;
 	}
 
 	template<typename TTraversingCb>
@@ -421,7 +742,10 @@ private:
 			return;
 		}
 		MiddleOrderWithRecursion(node->left.get(), std::forward<TTraversingCb>(fun));
-		fun(node->val);
+		if (IsAlive(node))
+		{
+			fun(node->val);
+		}
 		MiddleOrderWithRecursion(node->right.get(), std::forward<TTraversingCb>(fun));
 	}
 
@@ -445,7 +769,10 @@ private:
 			else
 			{
 				node = node_stack.top();
-				fun(node->val);
+				if (IsAlive(node))
+				{
+					fun(node->val);
+				}
 				node_stack.pop();
 				node = node->right.get();
 			}
@@ -459,7 +786,10 @@ private:
 		{
 			return;
 		}
-		fun(node->val);
+		if (IsAlive(node))
+		{
+			fun(node->val);
+		}
 		PreOrderWithRecursion(node->left.get(), std::forward<TTraversingCb>(fun));
 		PreOrderWithRecursion(node->right.get(), std::forward<TTraversingCb>(fun));
 	}
@@ -477,7 +807,10 @@ private:
 		{
 			if (node != nullptr)
 			{
-				fun(node->val);
+				if (IsAlive(node))
+				{
+					fun(node->val);
+				}
 				node_stack.push(node);
 				node = node->left.get();
 			}
@@ -499,7 +832,10 @@ private:
 		}
 		LastOrderWithRecursion(node->left.get(), std::forward<TTraversingCb>(fun));
 		LastOrderWithRecursion(node->right.get(), std::forward<TTraversingCb>(fun));
-		fun(node->val);
+		if (IsAlive(node))
+		{
+			fun(node->val);
+		}
 	}
 
 	template<typename TTraversingCb>
@@ -530,12 +866,244 @@ private:
 		}
 		while (!out_stack.empty())
 		{
-			fun(out_stack.top()->val);
+			if (IsAlive(out_stack.top()))
+			{
+				fun(out_stack.top()->val);
+			}
 			out_stack.pop();
 		}
 	}
 
-	const int Size(NodeType* node)const noexcept
+	// makenumڵ㣬мĽڵΪmakeĽڵûкӣ
+	template<typename TMaker>
+	UniqueNodeType Build(TMaker& make, int num)
+	{
+		if (num == 0)
+		{
+			return nullptr;
+		}
+
+		int left_num = (num - 1) / 2;
+
+		UniqueNodeType left = Build(make, left_num);
+		UniqueNodeType node = make();
+		node->left = std::move(left);
+		node->right = Build(make, num - 1 - left_num);
+		node->sub_node_num += Size(node->left.get()) + Size(node->right.get());
+
+		return node;
+	}
+
+	// ɹĴڵ㣬ֻʣĹֱͷ
+	void Flatten(UniqueNodeType node, std::vector<UniqueNodeType>& nodes)
+	{
+		std::vector<UniqueNodeType> stack;
+		while (node != nullptr || !stack.empty())
+		{
+			while (node != nullptr)
+			{
+				// ժʱļһֻʣ
+				UniqueNodeType left = std::move(node->left);
+				node->sub_node_num -= Size(left.get());
+				stack.push_back(std::move(node));
+				node = std::move(left);
+			}
+
+			node = std::move(stack.back());
+			stack.pop_back();
+
+			UniqueNodeType right = std::move(node->right);
+			node->sub_node_num -= Size(right.get());
+			if (node->sub_node_num > 0)
+			{
+				nodes.push_back(std::move(node));
+			}
+			else
+			{
+				alloc_.Free(std::move(node));
+				--dead_num_;
+			}
+			node = std::move(right);
+		}
+	}
+
+	// ؽȫƽĹͷţԪظ䣬ȵļõ
+	UniqueNodeType Rebuild(UniqueNodeType sub_root)
+	{
+		std::vector<UniqueNodeType> nodes;
+		nodes.reserve(Size(sub_root.get()));
+		Flatten(std::move(sub_root), nodes);
+
+		auto node_it = nodes.begin();
+		auto make = [&node_it]()
+		{
+			UniqueNodeType node = std::move(*node_it);
+			++node_it;
+			return node;
+		};
+		return Build(make, static_cast<int>(nodes.size()));
+	}
+
+	// ģʽµĲ룬ݹ飬Ѿ˻ʱҲջ
+	template<typename NodeValType>
+	void ScapegoatPut(NodeValType&& val)
+	{
+		// ²·ÿڵڵӣ·
+		std::vector<UniqueNodeType*> path;
+		UniqueNodeType* link = &root_;
+		while (*link != nullptr)
+		{
+			NodeType* node = link->get();
+			if (val < node->val)
+			{
+				path.push_back(link);
+				link = &node->left;
+			}
+			else if (node->val < val)
+			{
+				path.push_back(link);
+				link = &node->right;
+			}
+			else
+			{
+				// Ѵʱ䣬Ĺʱԭظãؼģʽ1ṹ
+				const bool alive = IsAlive(node);
+				if (!alive || multiset_)
+				{
+					if (!alive)
+					{
+						node->val = std::forward<NodeValType>(val);
+						--dead_num_;
+					}
+					++node->sub_node_num;
+					for (UniqueNodeType* parent : path)
+					{
+						++(*parent)->sub_node_num;
+					}
+				}
+				return;
+			}
+		}
+
+		*link = alloc_.New(std::forward<NodeValType>(val));
+		for (UniqueNodeType* parent : path)
+		{
+			++(*parent)->sub_node_num;
+		}
+
+		// ĹҲռȣȫڵ
+		const int node_num = Size() + dead_num_;
+		max_node_num_ = std::max(max_node_num_, node_num);
+		if (static_cast<int>(path.size()) <= MaxDepth(node_num))
+		{
+			return;
+		}
+
+		int child_num = 1;
+		for (auto it = path.rbegin(); it != path.rend(); ++it)
+		{
+			const int parent_num = Size((*it)->get());
+			if (child_num > scapegoat_alpha_ * parent_num)
+			{
+				**it = Rebuild(std::move(**it));
+				return;
+			}
+			child_num = parent_num;
+		}
+
+		// ĹС·ϿҲ򣬴ʱؽ˳Ĺ
+		Rebuild();
+	}
+
+	// ģʽ²ȵ
+	const int MaxDepth(int node_num)const noexcept
+	{
+		return static_cast<int>(std::log(static_cast<double>(node_num)) / std::log(1.0 / scapegoat_alpha_));
+	}
+
+	// ģʽɾڵǷ񽵵̫
+	void CheckShrink()
+	{
+		if (scapegoat_ && Size() + dead_num_ < scapegoat_alpha_ * max_node_num_)
+		{
+			Rebuild();
+		}
+	}
+
+	// ɾȷϴڣز·Ѽ1ɾĽڵ㱾
+	// ؼģʽ0ųΪĹ
+	template<typename NodeValType>
+	void LazyDelete(const NodeValType& val)
+	{
+		if (Get(val) == nullptr)
+		{
+			return;
+		}
+
+		NodeType* node = root_.get();
+		while (true)
+		{
+			--node->sub_node_num;
+			if (val < node->val)
+			{
+				node = node->left.get();
+			}
+			else if (node->val < val)
+			{
+				node = node->right.get();
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		if (IsAlive(node))
+		{
+			return;
+		}
+		++dead_num_;
+		if (dead_num_ > max_dead_ratio_ * (Size() + dead_num_))
+		{
+			Rebuild();
+		}
+	}
+
+	// nodeΪڵalloc
+	static UniqueNodeType Clone(const NodeType* node, AllocatorType& alloc, int parallel_depth)
+	{
+		if (node == nullptr)
+		{
+			return nullptr;
+		}
+
+		UniqueNodeType copy = alloc.New(node->val);
+		copy->sub_node_num = node->sub_node_num;
+
+		if (parallel_depth > 0 && node->sub_node_num >= kParallelMinNum)
+		{
+			std::thread worker([&]()
+				{
+					AllocatorType worker_alloc;
+					copy->left = Clone(node->left.get(), worker_alloc, parallel_depth - 1);
+				});
+			copy->right = Clone(node->right.get(), alloc, parallel_depth - 1);
+			worker.join();
+		}
+		else
+		{
+			copy->left = Clone(node->left.get(), alloc, parallel_depth);
+			copy->right = Clone(node->right.get(), alloc, parallel_depth);
+		}
+		return copy;
+	}
+
+	static const bool IsAlive(const NodeType* node)noexcept
+	{
+		return OwnNum(node) > 0;
+	}
+
+	static const int Size(const NodeType* node)noexcept
 	{
 		if (node == nullptr)
 		{
@@ -546,15 +1114,30 @@ private:
 	}
 	
 private:
+	// ʱôڵŽ߳
+	static const int kParallelMinNum = 1 << 14;
+
+	AllocatorType alloc_;
 	UniqueNodeType root_;
 
+	bool lazy_delete_ = false;
+	double max_dead_ratio_ = 0.25;
+	int dead_num_ = 0;
+
+	bool scapegoat_ = false;
+	double scapegoat_alpha_ = 0.7;
+	// ϴؽڵֵ
+	int max_node_num_ = 0;
+
+	bool multiset_ = false;
+
 };
 
-template<>
-class BinarySearchTree<float> {};
+template<template<typename> class TAllocator>
+class BinarySearchTree<float, TAllocator> {};
 
-template<>
-class BinarySearchTree<double> {};
+template<template<typename> class TAllocator>
+class BinarySearchTree<double, TAllocator> {};
 
 #endif // !TREE_H_
 
@@ -0,0 +1,102 @@
+#ifndef AUGMENT_H_
+#define AUGMENT_H_
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+// ڵϵľۺϲԣÿڵ㱣ΪۺϵĽתͲɾʱ·¼㡣
+// Ҫṩ
+//   ValueType                      ۺֵ
+//   static ValueType Identity()    λԪ
+//   static ValueType FromVal(const T& val)
+//   static ValueType Combine(const ValueType& left, const ValueType& right)  ɣleftλright֮ǰ
+// ValueTypeΪʱڵϲۺֵҲκά
+
+// Ĭϲۺ
+template<typename T>
+struct NoAugment
+{
+	struct ValueType
+	{
+	};
+
+	static ValueType Identity()noexcept
+	{
+		return ValueType();
+	}
+
+	static ValueType FromVal(const T&)noexcept
+	{
+		return ValueType();
+	}
+
+	static ValueType Combine(const ValueType&, const ValueType&)noexcept
+	{
+		return ValueType();
+	}
+};
+
+template<typename TAugment>
+struct IsAugmented :std::integral_constant<bool, !std::is_empty<typename TAugment::ValueType>::value>
+{
+};
+
+// TFieldȡֶ
+template<typename T, typename TField>
+struct SumAugment
+{
+	using ValueType = std::decay_t<decltype(std::declval<TField>()(std::declval<const T&>()))>;
+
+	static ValueType Identity()
+	{
+		return ValueType();
+	}
+
+	static ValueType FromVal(const T& val)
+	{
+		return TField()(val);
+	}
+
+	static ValueType Combine(const ValueType& left, const ValueType& right)
+	{
+		return left + right;
+	}
+};
+
+// TFieldȡֵֶõ͵Сֵ
+template<typename T, typename TField>
+struct MaxAugment
+{
+	using ValueType = std::decay_t<decltype(std::declval<TField>()(std::declval<const T&>()))>;
+
+	static ValueType Identity()
+	{
+		return std::numeric_limits<ValueType>::lowest();
+	}
+
+	static ValueType FromVal(const T& val)
+	{
+		return TField()(val);
+	}
+
+	static ValueType Combine(const ValueType& left, const ValueType& right)
+	{
+		return std::max(left, right);
+	}
+};
+
+// ڵϱۺֵĲ֣ۺʱǿջ࣬ռڵĿռ
+template<typename TAugment, bool = IsAugmented<TAugment>::value>
+struct NodeAugment
+{
+	typename TAugment::ValueType aug = TAugment::Identity();
+};
+
+template<typename TAugment>
+struct NodeAugment<TAugment, false>
+{
+};
+
+#endif // !AUGMENT_H_
@@ -0,0 +1,715 @@
+// ׼ԣ̶sorted/reverse/uniform/zipfָأ
+// ÿμʱÿһJSON׼ڽűԱȻع
+//
+
+#include "benchmark.h"
+
+#include "tree.h"
+#include "compact_tree.h"
+#include "snapshot_tree.h"
+#include "bplus_tree.h"
+#include "splay_tree.h"
+#include "sharded_tree.h"
+#include "tree_file.h"
+#include "tree_journal.h"
+#include "node_allocator.h"
+#include "tree_stats.h"
+#include "augment.h"
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <numeric>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cstdio>
+
+const char* kModule = "red_black_bst";
+
+// չĲѯṹconstģTTreeƵΪconst
+template<typename TTree>
+void RunReadOps(const char* tree_name, const char* workload, TTree& tree, const std::vector<int>& probes, int n)
+{
+	LatencyRecorder recorder(static_cast<int>(probes.size()));
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Get(key) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Get", n);
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Rank(key)); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Rank", n);
+
+	const int size = tree.Size();
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Select(key % size + 1) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Select", n);
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Floor(key) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Floor", n);
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Ceiling(key) != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Ceiling", n);
+
+	for (size_t i = 0; i < probes.size(); i++)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Min() != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Min", n);
+
+	for (size_t i = 0; i < probes.size(); i++)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Max() != nullptr); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Max", n);
+}
+
+// ֻвʵṩĲĬϲ
+template<typename TTree>
+void RunExtraOps(const char*, const char*, TTree&, const std::vector<int>&, int)
+{
+}
+
+template<typename T, template<typename> class TAllocator, typename TCompare>
+void RunExtraOps(const char* tree_name, const char* workload, RedBlackBST<T, TAllocator, TCompare>& tree, const std::vector<int>& probes, int n)
+{
+	LatencyRecorder recorder(static_cast<int>(probes.size()));
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.LowerBound(key) != tree.end()); });
+	}
+	recorder.Report(kModule, tree_name, workload, "LowerBound", n);
+
+	// ÿȡ[key, key + 200]֮Լ100Ԫ
+	for (int key : probes)
+	{
+		recorder.Measure([&]()
+		{
+			long long sum = 0;
+			for (int val : tree.Range(key, key + 200))
+			{
+				sum += val;
+			}
+			DoNotOptimize(sum);
+		});
+	}
+	recorder.Report(kModule, tree_name, workload, "Range", n);
+
+	recorder.MeasureBatch(tree.Size(), [&]()
+	{
+		long long sum = 0;
+		for (int val : tree)
+		{
+			sum += val;
+		}
+		DoNotOptimize(sum);
+	});
+	recorder.Report(kModule, tree_name, workload, "Iterate", n);
+
+	// żڵ֮ظģֵһ
+	std::vector<int> present(tree.begin(), tree.end());
+	for (int key : probes)
+	{
+		int& val = present[key % present.size()];
+		recorder.Measure([&]() { DoNotOptimize(tree.UpdateKey(val, val ^ 1)); });
+		val ^= 1;
+	}
+	recorder.Report(kModule, tree_name, workload, "UpdateKey", n);
+
+	// ģÿtickյһ£ԭݸϰkBatchNumһֱPutPutBatch
+	const int kBatchNum = 1000;
+	RedBlackBST<T, TAllocator, TCompare> put_tree;
+	RedBlackBST<T, TAllocator, TCompare> batch_tree;
+	put_tree.BuildFromSorted(tree.begin(), tree.end());
+	batch_tree.BuildFromSorted(tree.begin(), tree.end());
+	for (size_t i = 0; i < probes.size(); i += kBatchNum)
+	{
+		auto first = probes.begin() + i;
+		auto last = probes.begin() + std::min(probes.size(), i + kBatchNum);
+		recorder.MeasureBatch(static_cast<int>(last - first), [&]()
+		{
+			for (auto it = first; it != last; ++it)
+			{
+				put_tree.Put(*it);
+			}
+		});
+	}
+	recorder.Report(kModule, tree_name, workload, "TickPut", n);
+
+	for (size_t i = 0; i < probes.size(); i += kBatchNum)
+	{
+		auto first = probes.begin() + i;
+		auto last = probes.begin() + std::min(probes.size(), i + kBatchNum);
+		recorder.MeasureBatch(static_cast<int>(last - first), [&]() { batch_tree.PutBatch(first, last); });
+	}
+	recorder.Report(kModule, tree_name, workload, "PutBatch", n);
+
+	// ˳׷ӣȴӸ룬ÿһηصĵΪʾ
+	RedBlackBST<T, TAllocator, TCompare> append_tree;
+	for (int val : tree)
+	{
+		recorder.Measure([&]() { append_tree.Put(val); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Append", n);
+
+	RedBlackBST<T, TAllocator, TCompare> hint_tree;
+	auto hint = hint_tree.end();
+	for (int val : tree)
+	{
+		recorder.Measure([&]() { hint = hint_tree.Put(hint, val); });
+	}
+	recorder.Report(kModule, tree_name, workload, "HintedAppend", n);
+
+	// keyпƴȥÿμʱһSplitһJoin
+	RedBlackBST<T, TAllocator, TCompare> right_tree;
+	for (int key : probes)
+	{
+		recorder.Measure([&]()
+		{
+			tree.Split(key, right_tree);
+			DoNotOptimize(tree.Join(right_tree));
+		});
+	}
+	recorder.Report(kModule, tree_name, workload, "SplitJoin", n);
+}
+
+// дϣдһPutһDeleteĹģ²
+template<typename TTree>
+void RunMixedOps(const char* tree_name, const char* workload, const char* op, int read_percent, TTree& tree, const std::vector<int>& probes, int n, uint64_t seed)
+{
+	LatencyRecorder recorder(static_cast<int>(probes.size()));
+	std::mt19937_64 engine(seed);
+
+	bool put_next = true;
+	for (int key : probes)
+	{
+		if (static_cast<int>(engine() % 100) < read_percent)
+		{
+			recorder.Measure([&]() { DoNotOptimize(tree.Get(key) != nullptr); });
+			continue;
+		}
+
+		int write_key = key & ~1;
+		if (put_next)
+		{
+			recorder.Measure([&]() { tree.Put(write_key); });
+		}
+		else
+		{
+			recorder.Measure([&]() { tree.Delete(write_key); });
+		}
+		put_next = !put_next;
+	}
+	recorder.Report(kModule, tree_name, workload, op, n);
+}
+
+// RED_BLACK_BST_STATSʱһڼ䵱ǰ߳ۼƵļ
+void ReportTreeStats(const char* tree_name, const char* workload, int n)
+{
+	const TreeStats stats = TakeThreadTreeStats();
+	if (!kTreeStatsEnabled)
+	{
+		return;
+	}
+
+	std::printf("{\"module\":\"%s\",\"tree\":\"%s\",\"workload\":\"%s\",\"op\":\"Stats\",\"n\":%d,"
+		"\"rotate_left\":%llu,\"rotate_right\":%llu,\"flip_color\":%llu,\"move_red_left\":%llu,\"move_red_right\":%llu,"
+		"\"balance\":%llu,\"put_compare\":%llu,\"get_compare\":%llu,\"node_alloc\":%llu,\"node_free\":%llu}\n",
+		kModule, tree_name, workload, n,
+		static_cast<unsigned long long>(stats.rotate_left), static_cast<unsigned long long>(stats.rotate_right),
+		static_cast<unsigned long long>(stats.flip_color), static_cast<unsigned long long>(stats.move_red_left),
+		static_cast<unsigned long long>(stats.move_red_right), static_cast<unsigned long long>(stats.balance),
+		static_cast<unsigned long long>(stats.put_compare), static_cast<unsigned long long>(stats.get_compare),
+		static_cast<unsigned long long>(stats.node_alloc), static_cast<unsigned long long>(stats.node_free));
+	std::fflush(stdout);
+}
+
+template<typename TTree>
+void RunWorkload(const char* tree_name, KeyOrder order, const BenchConfig& config)
+{
+	const char* workload = KeyOrderName(order);
+	const int n = config.n;
+	TakeThreadTreeStats();
+
+	auto keys = MakeKeys(order, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(order, config.ops, n, config.theta, config.seed + 1);
+
+	TTree tree;
+	LatencyRecorder recorder(std::max(n, config.ops));
+
+	for (int key : keys)
+	{
+		recorder.Measure([&]() { tree.Put(key); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Put", n);
+
+	RunReadOps(tree_name, workload, tree, probes, n);
+	RunExtraOps(tree_name, workload, tree, probes, n);
+
+	RunMixedOps(tree_name, workload, "Mixed95", 95, tree, probes, n, config.seed + 2);
+	RunMixedOps(tree_name, workload, "Mixed50", 50, tree, probes, n, config.seed + 3);
+
+	for (int key : keys)
+	{
+		recorder.Measure([&]() { tree.Delete(key); });
+	}
+	recorder.Report(kModule, tree_name, workload, "Delete", n);
+
+	std::vector<int> sorted_keys(keys);
+	std::sort(sorted_keys.begin(), sorted_keys.end());
+	sorted_keys.erase(std::unique(sorted_keys.begin(), sorted_keys.end()), sorted_keys.end());
+
+	recorder.MeasureBatch(static_cast<int>(sorted_keys.size()), [&]() { tree.BuildFromSorted(sorted_keys.begin(), sorted_keys.end()); });
+	recorder.Report(kModule, tree_name, workload, "BuildFromSorted", n);
+
+	const int half = tree.Size() / 2;
+	for (int i = 0; i < half; i++)
+	{
+		recorder.Measure([&]() { tree.DelMin(); });
+	}
+	recorder.Report(kModule, tree_name, workload, "DelMin", n);
+
+	while (!tree.IsEmpty())
+	{
+		recorder.Measure([&]() { tree.DelMax(); });
+	}
+	recorder.Report(kModule, tree_name, workload, "DelMax", n);
+
+	ReportTreeStats(tree_name, workload, n);
+}
+
+template<typename TTree>
+void RunAllWorkloads(const char* tree_name, const BenchConfig& config)
+{
+	RunWorkload<TTree>(tree_name, KeyOrder::kSorted, config);
+	RunWorkload<TTree>(tree_name, KeyOrder::kReverse, config);
+	RunWorkload<TTree>(tree_name, KeyOrder::kUniform, config);
+	RunWorkload<TTree>(tree_name, KeyOrder::kZipf, config);
+}
+
+// ֻֻѯRedBlackBSTͬһݸ
+void RunFrozenWorkload(KeyOrder order, const BenchConfig& config)
+{
+	const char* workload = KeyOrderName(order);
+	const int n = config.n;
+
+	auto keys = MakeKeys(order, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(order, config.ops, n, config.theta, config.seed + 1);
+
+	RedBlackBST<int> tree;
+	for (int key : keys)
+	{
+		tree.Put(key);
+	}
+
+	LatencyRecorder recorder(1);
+	std::unique_ptr<FrozenRedBlackBST<int>> frozen;
+	recorder.MeasureBatch(tree.Size(), [&]() { frozen.reset(new FrozenRedBlackBST<int>(tree.Freeze())); });
+	recorder.Report(kModule, "FrozenRedBlackBST", workload, "Freeze", n);
+
+	RunReadOps("FrozenRedBlackBST", workload, *frozen, probes, n);
+}
+
+struct IntVal
+{
+	long long operator()(int val)const
+	{
+		return val;
+	}
+};
+
+using SumRedBlackBST = RedBlackBST<int, HeapNodeAllocator, std::less<int>, SumAugment<int, IntVal>>;
+
+// ;ۺϵRedBlackBSTԱȸ·϶ĿٶԱȰۺֵǰkTopNumĺ
+void RunAugmentWorkload(KeyOrder order, const BenchConfig& config)
+{
+	RunWorkload<SumRedBlackBST>("RedBlackBST<Sum>", order, config);
+
+	const char* workload = KeyOrderName(order);
+	const int n = config.n;
+	const int kTopNum = 1000;
+
+	auto keys = MakeKeys(order, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(order, config.ops, n, config.theta, config.seed + 1);
+
+	SumRedBlackBST tree;
+	for (int key : keys)
+	{
+		tree.Put(key);
+	}
+
+	LatencyRecorder recorder(static_cast<int>(probes.size()));
+	const int size = tree.Size();
+	for (size_t i = 0; i < probes.size(); i++)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.AggregateByRank(size - kTopNum + 1, size)); });
+	}
+	recorder.Report(kModule, "RedBlackBST<Sum>", workload, "TopSum", n);
+
+	const size_t traverse_num = std::min<size_t>(probes.size(), 1000);
+	for (size_t i = 0; i < traverse_num; i++)
+	{
+		recorder.Measure([&]()
+		{
+			long long sum = 0;
+			int ranking = 0;
+			for (auto it = tree.rbegin(); it != tree.rend() && ranking < kTopNum; ++it, ++ranking)
+			{
+				sum += *it;
+			}
+			DoNotOptimize(sum);
+		});
+	}
+	recorder.Report(kModule, "RedBlackBST<Sum>", workload, "TopSumTraverse", n);
+
+	for (int key : probes)
+	{
+		recorder.Measure([&]() { DoNotOptimize(tree.Aggregate(key, key + 200)); });
+	}
+	recorder.Report(kModule, "RedBlackBST<Sum>", workload, "RangeSum", n);
+}
+
+// ļдļO(N)ؽӳֱӲѯ
+void RunTreeFileWorkload(KeyOrder order, const BenchConfig& config)
+{
+	const char* workload = KeyOrderName(order);
+	const char* path = "red_black_bst_benchmark.tree";
+	const int n = config.n;
+
+	auto keys = MakeKeys(order, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(order, config.ops, n, config.theta, config.seed + 1);
+
+	RedBlackBST<int> tree;
+	for (int key : keys)
+	{
+		tree.Put(key);
+	}
+
+	LatencyRecorder recorder(1);
+	recorder.MeasureBatch(tree.Size(), [&]() { DoNotOptimize(SaveTreeFile(tree, path)); });
+	recorder.Report(kModule, "MappedTree", workload, "SaveTreeFile", n);
+
+	RedBlackBST<int, PoolNodeAllocator> loaded_tree;
+	recorder.MeasureBatch(tree.Size(), [&]() { DoNotOptimize(LoadTreeFile(loaded_tree, path)); });
+	recorder.Report(kModule, "MappedTree", workload, "LoadTreeFile", n);
+
+	MappedTree<int> mapped;
+	recorder.Measure([&]() { DoNotOptimize(mapped.Open(path)); });
+	recorder.Report(kModule, "MappedTree", workload, "Open", n);
+
+	RunReadOps("MappedTree", workload, mapped, probes, n);
+
+	mapped.Close();
+	std::remove(path);
+}
+
+// ־д룬RedBlackBSTͬһµPutUpdateKeyԱȼΪ־Ŀ
+void RunJournalWorkload(const char* tree_name, KeyOrder order, const JournalOptions& options, const BenchConfig& config)
+{
+	const char* workload = KeyOrderName(order);
+	const char* snapshot_path = "red_black_bst_benchmark.tree";
+	const char* journal_path = "red_black_bst_benchmark.journal";
+	const int n = config.n;
+
+	auto keys = MakeKeys(order, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(order, config.ops, n, config.theta, config.seed + 1);
+
+	std::remove(snapshot_path);
+	std::remove(journal_path);
+
+	{
+		JournaledTree<RedBlackBST<int>> tree(options);
+		if (!tree.Open(snapshot_path, journal_path))
+		{
+			std::fprintf(stderr, "open journal failed\n");
+			return;
+		}
+
+		LatencyRecorder recorder(std::max(n, config.ops));
+		for (int key : keys)
+		{
+			recorder.Measure([&]() { tree.Put(key); });
+		}
+		recorder.Report(kModule, tree_name, workload, "Put", n);
+
+		std::vector<int> present(tree.GetTree().begin(), tree.GetTree().end());
+		for (int key : probes)
+		{
+			int& val = present[key % present.size()];
+			recorder.Measure([&]() { DoNotOptimize(tree.UpdateKey(val, val ^ 1)); });
+			val ^= 1;
+		}
+		recorder.Report(kModule, tree_name, workload, "UpdateKey", n);
+
+		recorder.MeasureBatch(tree.GetTree().Size(), [&]() { DoNotOptimize(tree.Checkpoint()); });
+		recorder.Report(kModule, tree_name, workload, "Checkpoint", n);
+	}
+
+	// ֻ־ûļʱĻָдһ־´ط
+	std::remove(snapshot_path);
+	std::remove(journal_path);
+	{
+		JournaledTree<RedBlackBST<int>> tree(options);
+		tree.Open(snapshot_path, journal_path);
+		for (int key : keys)
+		{
+			tree.Put(key);
+		}
+	}
+	{
+		JournaledTree<RedBlackBST<int>> tree(options);
+		LatencyRecorder recorder(1);
+		recorder.MeasureBatch(n, [&]() { DoNotOptimize(tree.Open(snapshot_path, journal_path)); });
+		recorder.Report(kModule, tree_name, workload, "Replay", n);
+	}
+
+	std::remove(snapshot_path);
+	std::remove(journal_path);
+}
+
+// նչԣһд̲߳ͣUpdateKey߳1ʼÿRankȡ
+void RunSnapshotScaling(const BenchConfig& config)
+{
+	const int n = config.n;
+	auto keys = MakeKeys(KeyOrder::kUniform, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(KeyOrder::kUniform, config.ops, n, config.theta, config.seed + 1);
+
+	SnapshotRedBlackBST<int> tree;
+	for (int key : keys)
+	{
+		tree.Put(key);
+	}
+
+	const int max_threads = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), 16));
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		std::atomic<bool> stop(false);
+		std::thread writer([&]()
+		{
+			std::mt19937_64 engine(config.seed + 4);
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				int key = keys[engine() % keys.size()];
+				tree.UpdateKey(key, key ^ 1);
+				tree.UpdateKey(key ^ 1, key);
+			}
+		});
+
+		// ÿ̶߳ѯȫprobes
+		std::vector<LatencyRecorder> recorders(threads, LatencyRecorder(config.ops));
+		std::vector<long long> sums(threads, 0);
+		std::vector<std::thread> readers;
+
+		auto begin = LatencyRecorder::Clock::now();
+		for (int i = 0; i < threads; i++)
+		{
+			readers.emplace_back([&, i]()
+			{
+				long long sum = 0;
+				for (int key : probes)
+				{
+					recorders[i].Measure([&]() { sum += tree.Rank(key); });
+				}
+				sums[i] = sum;
+			});
+		}
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+		auto end = LatencyRecorder::Clock::now();
+		DoNotOptimize(std::accumulate(sums.begin(), sums.end(), 0LL));
+
+		stop.store(true);
+		writer.join();
+
+		LatencyRecorder recorder(0);
+		for (const auto& other : recorders)
+		{
+			recorder.Merge(other);
+		}
+		recorder.SetElapsed(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+		recorder.Report(kModule, "SnapshotRedBlackBST", "uniform", "SnapshotRank", n, threads);
+	}
+}
+
+// ƬдչԣƬд߳ÿ߳дkeysеһ֣̲֮߳ȫRank/Select
+void RunShardedScaling(const BenchConfig& config)
+{
+	const int n = config.n;
+	auto keys = MakeKeys(KeyOrder::kUniform, n, n, config.theta, config.seed);
+	auto probes = MakeProbes(KeyOrder::kUniform, config.ops, n, config.theta, config.seed + 1);
+
+	const int max_threads = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), 16));
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		ShardedRedBlackBST<int> tree(threads);
+
+		std::vector<LatencyRecorder> recorders(threads, LatencyRecorder(n / threads + 1));
+		std::vector<std::thread> writers;
+
+		auto begin = LatencyRecorder::Clock::now();
+		for (int i = 0; i < threads; i++)
+		{
+			writers.emplace_back([&, i]()
+			{
+				for (int j = i; j < n; j += threads)
+				{
+					recorders[i].Measure([&]() { tree.Put(keys[j]); });
+				}
+			});
+		}
+		for (auto& writer : writers)
+		{
+			writer.join();
+		}
+		auto end = LatencyRecorder::Clock::now();
+
+		LatencyRecorder recorder(config.ops);
+		for (const auto& other : recorders)
+		{
+			recorder.Merge(other);
+		}
+		recorder.SetElapsed(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+		recorder.Report(kModule, "ShardedRedBlackBST", "uniform", "ShardedPut", n, threads);
+
+		for (int key : probes)
+		{
+			recorder.Measure([&]() { DoNotOptimize(tree.Rank(key)); });
+		}
+		recorder.Report(kModule, "ShardedRedBlackBST", "uniform", "ShardedRank", n, threads);
+
+		const int size = tree.Size();
+		for (int key : probes)
+		{
+			int val = 0;
+			recorder.Measure([&]() { DoNotOptimize(tree.Select(key % size + 1, val)); });
+		}
+		recorder.Report(kModule, "ShardedRedBlackBST", "uniform", "ShardedSelect", n, threads);
+	}
+}
+
+// ønԪءֵ򲿷ص㣬߳ͳƣÿǰڼʱ֮ؽ
+void RunSetOpsScaling(const BenchConfig& config)
+{
+	const int n = config.n;
+	auto left_keys = MakeKeys(KeyOrder::kUniform, n, n * 2, config.theta, config.seed);
+	auto right_keys = MakeKeys(KeyOrder::kUniform, n, n * 2, config.theta, config.seed + 1);
+	std::sort(left_keys.begin(), left_keys.end());
+	left_keys.erase(std::unique(left_keys.begin(), left_keys.end()), left_keys.end());
+	std::sort(right_keys.begin(), right_keys.end());
+	right_keys.erase(std::unique(right_keys.begin(), right_keys.end()), right_keys.end());
+
+	const char* op_names[] = { "Union", "Intersection", "Difference" };
+	const int kRepeat = 5;
+
+	const int max_threads = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), 16));
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		for (int op = 0; op < 3; op++)
+		{
+			LatencyRecorder recorder(kRepeat);
+			for (int i = 0; i < kRepeat; i++)
+			{
+				RedBlackBST<int> left_tree;
+				RedBlackBST<int> right_tree;
+				left_tree.BuildFromSorted(left_keys.begin(), left_keys.end());
+				right_tree.BuildFromSorted(right_keys.begin(), right_keys.end());
+
+				recorder.MeasureBatch(static_cast<int>(left_keys.size() + right_keys.size()), [&]()
+				{
+					if (op == 0)
+					{
+						left_tree.Union(right_tree, threads);
+					}
+					else if (op == 1)
+					{
+						left_tree.Intersection(right_tree, threads);
+					}
+					else
+					{
+						left_tree.Difference(right_tree, threads);
+					}
+				});
+				DoNotOptimize(left_tree.Size());
+			}
+			recorder.Report(kModule, "RedBlackBST", "uniform", op_names[op], n, threads);
+		}
+	}
+}
+
+// һnԪص߳ͳƣڼʱ֮
+void RunCloneScaling(const BenchConfig& config)
+{
+	const int n = config.n;
+	auto keys = MakeKeys(KeyOrder::kUniform, n, n * 2, config.theta, config.seed);
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	RedBlackBST<int> tree;
+	tree.BuildFromSorted(keys.begin(), keys.end());
+
+	const int kRepeat = 5;
+	const int max_threads = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), 16));
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		LatencyRecorder recorder(kRepeat);
+		for (int i = 0; i < kRepeat; i++)
+		{
+			RedBlackBST<int> copy;
+			recorder.MeasureBatch(tree.Size(), [&]() { copy = tree.Clone(threads); });
+			DoNotOptimize(copy.Size());
+		}
+		recorder.Report(kModule, "RedBlackBST", "uniform", "Clone", n, threads);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchConfig config;
+	if (!config.Parse(argc, argv))
+	{
+		return 1;
+	}
+
+	RunAllWorkloads<RedBlackBST<int>>("RedBlackBST", config);
+	RunAllWorkloads<RedBlackBST<int, PoolNodeAllocator>>("RedBlackBST<Pool>", config);
+	RunAllWorkloads<CompactRedBlackBST<int>>("CompactRedBlackBST", config);
+	RunAllWorkloads<BPlusTree<int>>("BPlusTree", config);
+	RunAllWorkloads<SplayTree<int>>("SplayTree", config);
+
+	RunFrozenWorkload(KeyOrder::kSorted, config);
+	RunFrozenWorkload(KeyOrder::kReverse, config);
+	RunFrozenWorkload(KeyOrder::kUniform, config);
+	RunFrozenWorkload(KeyOrder::kZipf, config);
+
+	RunAugmentWorkload(KeyOrder::kUniform, config);
+
+	RunTreeFileWorkload(KeyOrder::kUniform, config);
+
+	JournalOptions journal_options;
+	RunJournalWorkload("JournaledRedBlackBST", KeyOrder::kUniform, journal_options, config);
+	journal_options.sync = false;
+	RunJournalWorkload("JournaledRedBlackBST<NoSync>", KeyOrder::kUniform, journal_options, config);
+
+	RunSnapshotScaling(config);
+	RunShardedScaling(config);
+	RunSetOpsScaling(config);
+	RunCloneScaling(config);
+
+	return 0;
+}
@@ -0,0 +1,270 @@
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// keyɷʽ
+enum class KeyOrder
+{
+	kSorted,
+	kReverse,
+	kUniform,
+	kZipf,
+};
+
+inline const char* KeyOrderName(KeyOrder order)noexcept
+{
+	switch (order)
+	{
+	case KeyOrder::kSorted:
+		return "sorted";
+	case KeyOrder::kReverse:
+		return "reverse";
+	case KeyOrder::kUniform:
+		return "uniform";
+	case KeyOrder::kZipf:
+		return "zipf";
+	}
+
+	return "unknown";
+}
+
+// вn=Ĺģ ops=ÿĴ seed= theta=Zipfֲƫб
+struct BenchConfig
+{
+	int n = 100000;
+	int ops = 100000;
+	uint64_t seed = 1;
+	double theta = 0.99;
+
+	// ֧ --n=100000 --ops=100000 --seed=1 --theta=0.99
+	bool Parse(int argc, char* argv[])
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* arg = argv[i];
+			if (std::strncmp(arg, "--n=", 4) == 0)
+			{
+				n = std::atoi(arg + 4);
+			}
+			else if (std::strncmp(arg, "--ops=", 6) == 0)
+			{
+				ops = std::atoi(arg + 6);
+			}
+			else if (std::strncmp(arg, "--seed=", 7) == 0)
+			{
+				seed = std::strtoull(arg + 7, nullptr, 10);
+			}
+			else if (std::strncmp(arg, "--theta=", 8) == 0)
+			{
+				theta = std::atof(arg + 8);
+			}
+			else
+			{
+				std::fprintf(stderr, "usage: %s [--n=N] [--ops=N] [--seed=N] [--theta=F]\n", argv[0]);
+				return false;
+			}
+		}
+
+		return n > 0 && ops > 0;
+	}
+};
+
+// Zipfֲ[0, n)֮ԽСֵԽƵԤۻֲֲ
+class ZipfGenerator
+{
+public:
+	ZipfGenerator(int n, double theta, uint64_t seed) :cdf_(n), engine_(seed), uniform_(0.0, 1.0)
+	{
+		double sum = 0.0;
+		for (int i = 0; i < n; i++)
+		{
+			sum += 1.0 / std::pow(static_cast<double>(i + 1), theta);
+			cdf_[i] = sum;
+		}
+		for (auto& val : cdf_)
+		{
+			val /= sum;
+		}
+	}
+
+	int Next()
+	{
+		auto it = std::lower_bound(cdf_.begin(), cdf_.end(), uniform_(engine_));
+		if (it == cdf_.end())
+		{
+			--it;
+		}
+		return static_cast<int>(it - cdf_.begin());
+	}
+
+private:
+	std::vector<double> cdf_;
+	std::mt19937_64 engine_;
+	std::uniform_real_distribution<double> uniform_;
+};
+
+// numkeyȡֵΧ[0, 2 * key_space)żѯʱȻ
+// sorted/reverseظuniform/zipfظzipfȵkeyȡֵΧɢ
+inline std::vector<int> MakeKeys(KeyOrder order, int num, int key_space, double theta, uint64_t seed)
+{
+	std::vector<int> keys(num);
+	switch (order)
+	{
+	case KeyOrder::kSorted:
+		for (int i = 0; i < num; i++)
+		{
+			keys[i] = i * 2;
+		}
+		break;
+	case KeyOrder::kReverse:
+		for (int i = 0; i < num; i++)
+		{
+			keys[i] = (num - 1 - i) * 2;
+		}
+		break;
+	case KeyOrder::kUniform:
+	{
+		std::mt19937_64 engine(seed);
+		std::uniform_int_distribution<int> dist(0, key_space - 1);
+		for (auto& key : keys)
+		{
+			key = dist(engine) * 2;
+		}
+		break;
+	}
+	case KeyOrder::kZipf:
+	{
+		std::vector<int> ranks(key_space);
+		std::iota(ranks.begin(), ranks.end(), 0);
+		std::shuffle(ranks.begin(), ranks.end(), std::mt19937_64(seed ^ 0x9E3779B97F4A7C15ull));
+
+		ZipfGenerator zipf(key_space, theta, seed);
+		for (auto& key : keys)
+		{
+			key = ranks[zipf.Next()] * 2;
+		}
+		break;
+	}
+	}
+
+	return keys;
+}
+
+// ѯõkeysorted/reverseĲѯȷֲķֲһ£ż
+inline std::vector<int> MakeProbes(KeyOrder order, int num, int key_space, double theta, uint64_t seed)
+{
+	KeyOrder probe_order = (order == KeyOrder::kZipf) ? KeyOrder::kZipf : KeyOrder::kUniform;
+	auto probes = MakeKeys(probe_order, num, key_space, theta, seed);
+
+	std::mt19937_64 engine(seed + 1);
+	for (auto& key : probes)
+	{
+		key += static_cast<int>(engine() & 1);
+	}
+
+	return probes;
+}
+
+// μ¼ĺʱºͷλÿһJSON
+class LatencyRecorder
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit LatencyRecorder(int reserve_num)
+	{
+		samples_.reserve(reserve_num);
+	}
+
+	template<typename TFun>
+	void Measure(TFun&& fun)
+	{
+		auto begin = Clock::now();
+		fun();
+		auto end = Clock::now();
+
+		samples_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+	}
+
+	// ʱһop_numβBuild޷ֵĲ
+	template<typename TFun>
+	void MeasureBatch(int op_num, TFun&& fun)
+	{
+		auto begin = Clock::now();
+		fun();
+		auto end = Clock::now();
+
+		batch_op_num_ += op_num - 1;
+		samples_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+	}
+
+	// ϲ̼߳¼
+	void Merge(const LatencyRecorder& other)
+	{
+		samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+		batch_op_num_ += other.batch_op_num_;
+	}
+
+	// ߳ʱ°ǽʱ㣬ʱ֮ͼ
+	void SetElapsed(long long elapsed_ns)noexcept
+	{
+		elapsed_ns_ = elapsed_ns;
+	}
+
+	void Report(const char* module, const char* tree, const char* workload, const char* op, int n, int threads = 1)
+	{
+		const long long op_num = static_cast<long long>(samples_.size()) + batch_op_num_;
+		const long long total_ns = elapsed_ns_ > 0 ? elapsed_ns_ : std::accumulate(samples_.begin(), samples_.end(), 0LL);
+		const double ops_per_sec = total_ns > 0 ? op_num * 1e9 / total_ns : 0.0;
+
+		std::sort(samples_.begin(), samples_.end());
+
+		std::printf("{\"module\":\"%s\",\"tree\":\"%s\",\"workload\":\"%s\",\"op\":\"%s\",\"n\":%d,\"threads\":%d,\"ops\":%lld,"
+			"\"ops_per_sec\":%.1f,\"p50_ns\":%lld,\"p99_ns\":%lld,\"p999_ns\":%lld}\n",
+			module, tree, workload, op, n, threads, op_num, ops_per_sec, Percentile(0.5), Percentile(0.99), Percentile(0.999));
+		std::fflush(stdout);
+
+		samples_.clear();
+		batch_op_num_ = 0;
+		elapsed_ns_ = 0;
+	}
+
+private:
+	long long Percentile(double ratio)const noexcept
+	{
+		if (samples_.empty())
+		{
+			return 0;
+		}
+
+		size_t index = static_cast<size_t>(std::ceil(ratio * samples_.size()));
+		index = index == 0 ? 0 : index - 1;
+
+		return samples_[std::min(index, samples_.size() - 1)];
+	}
+
+private:
+	std::vector<long long> samples_;
+	long long batch_op_num_ = 0;
+	long long elapsed_ns_ = 0;
+};
+
+// ֹѯŻ
+inline void DoNotOptimize(long long val)noexcept
+{
+	static volatile long long sink = 0;
+	sink = sink + val;
+}
+
+#endif // !BENCHMARK_H_
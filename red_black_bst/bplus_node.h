@@ -0,0 +1,178 @@
+#ifndef BPLUS_NODE_H_
+#define BPLUS_NODE_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// ѯӿڷصԪأNodeһͨ->valȡֵ
+template<typename T>
+struct BPlusEntry
+{
+	BPlusEntry() = delete;
+
+	template<typename NodeValType>
+	explicit BPlusEntry(NodeValType&& param) :val(std::forward<NodeValType>(param))
+	{
+	}
+
+	BPlusEntry(const BPlusEntry&) = default;
+	BPlusEntry(BPlusEntry&&) = default;
+	BPlusEntry& operator=(const BPlusEntry&) = default;
+	BPlusEntry& operator=(BPlusEntry&&) = default;
+
+	T val;
+};
+
+// Ԫ飬ֻǰnumԪأԪͲҪĬϹ캯
+template<typename T, int kCapacity>
+class SlotArray
+{
+public:
+	SlotArray() = default;
+	SlotArray(const SlotArray&) = delete;
+	SlotArray& operator=(const SlotArray&) = delete;
+
+	~SlotArray()
+	{
+		Clear();
+	}
+
+	T& operator[](int index)noexcept
+	{
+		return *reinterpret_cast<T*>(&slots_[index]);
+	}
+
+	const T& operator[](int index)const noexcept
+	{
+		return *reinterpret_cast<const T*>(&slots_[index]);
+	}
+
+	const int Num()const noexcept
+	{
+		return num_;
+	}
+
+	template<typename... Args>
+	void Insert(int pos, Args&&... args)
+	{
+		if (pos == num_)
+		{
+			new(&slots_[num_]) T(std::forward<Args>(args)...);
+			++num_;
+			return;
+		}
+
+		// ȹԪأƣеԪ
+		T tmp(std::forward<Args>(args)...);
+		new(&slots_[num_]) T(std::move((*this)[num_ - 1]));
+		for (int i = num_ - 1; i > pos; i--)
+		{
+			(*this)[i] = std::move((*this)[i - 1]);
+		}
+		(*this)[pos] = std::move(tmp);
+		++num_;
+	}
+
+	template<typename... Args>
+	void Append(Args&&... args)
+	{
+		new(&slots_[num_]) T(std::forward<Args>(args)...);
+		++num_;
+	}
+
+	void Erase(int pos)
+	{
+		for (int i = pos; i < num_ - 1; i++)
+		{
+			(*this)[i] = std::move((*this)[i + 1]);
+		}
+		(*this)[num_ - 1].~T();
+		--num_;
+	}
+
+	// [pos, num)Ƶotherĩβ
+	void MoveTailTo(int pos, SlotArray& other)
+	{
+		for (int i = pos; i < num_; i++)
+		{
+			other.Append(std::move((*this)[i]));
+			(*this)[i].~T();
+		}
+		num_ = pos;
+	}
+
+	void Clear()noexcept
+	{
+		for (int i = 0; i < num_; i++)
+		{
+			(*this)[i].~T();
+		}
+		num_ = 0;
+	}
+
+private:
+	int num_ = 0;
+	typename std::aligned_storage<sizeof(T), alignof(T)>::type slots_[kCapacity];
+};
+
+// ڵ㰴kNodeBytesͬһڵļ
+struct BPlusNodeBase
+{
+	static const size_t kNodeBytes = 256;
+
+	explicit BPlusNodeBase(bool leaf) :is_leaf(leaf)
+	{
+	}
+
+	bool is_leaf;
+};
+
+// ҶӽڵԪأ˫ȡǰ
+template<typename T>
+struct BPlusLeaf : public BPlusNodeBase
+{
+	static const int kCapacity = (kNodeBytes - 3 * sizeof(void*)) / sizeof(BPlusEntry<T>) > 4 ? static_cast<int>((kNodeBytes - 3 * sizeof(void*)) / sizeof(BPlusEntry<T>)) : 4;
+	static const int kMinNum = kCapacity / 2;
+
+	BPlusLeaf() :BPlusNodeBase(true), prev(nullptr), next(nullptr)
+	{
+	}
+
+	BPlusLeaf* prev;
+	BPlusLeaf* next;
+	SlotArray<BPlusEntry<T>, kCapacity> entries;
+};
+
+// ڲڵ㣬keys[i]children[i + 1]еСֵɾƫСȷָ
+// counts[i]children[i]еԪ
+template<typename T>
+struct BPlusInner : public BPlusNodeBase
+{
+	static const int kCapacity = kNodeBytes / (sizeof(T) + sizeof(void*) + sizeof(int)) > 4 ? static_cast<int>(kNodeBytes / (sizeof(T) + sizeof(void*) + sizeof(int))) : 4;
+	static const int kMinNum = (kCapacity + 1) / 2;
+
+	BPlusInner() :BPlusNodeBase(false), child_num(0)
+	{
+	}
+
+	int child_num;
+	SlotArray<T, kCapacity - 1> keys;
+	BPlusNodeBase* children[kCapacity];
+	int counts[kCapacity];
+};
+
+template<typename T>
+const int BPlusLeaf<T>::kCapacity;
+
+template<typename T>
+const int BPlusLeaf<T>::kMinNum;
+
+template<typename T>
+const int BPlusInner<T>::kCapacity;
+
+template<typename T>
+const int BPlusInner<T>::kMinNum;
+
+#endif // !BPLUS_NODE_H_
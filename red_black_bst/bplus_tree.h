@@ -0,0 +1,1056 @@
+#ifndef BPLUS_TREE_H_
+#define BPLUS_TREE_H_
+
+#include "bplus_node.h"
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// B+ӿRedBlackBSTһ
+// ڵ㰴еÿֻһָתԼΪlog(N)/log(ȳ)
+// ڲڵ¼ÿԪRankSelectO(log N)
+// ѯصԪָһ޸֮ʧЧ
+template<typename T>
+class BPlusTree
+{
+public:
+	using RealTType = std::remove_reference_t<std::decay_t<T>>;
+	using NodeType = BPlusEntry<RealTType>;
+	using LeafType = BPlusLeaf<RealTType>;
+	using InnerType = BPlusInner<RealTType>;
+
+	BPlusTree() :root_(nullptr), head_(nullptr), tail_(nullptr), size_(0), height_(0), leaf_num_(0), inner_num_(0)
+	{
+	}
+
+	~BPlusTree()
+	{
+		Clear();
+	}
+
+	BPlusTree(const BPlusTree&) = delete;
+	BPlusTree& operator=(const BPlusTree&) = delete;
+
+	BPlusTree(BPlusTree&&) = delete;
+	BPlusTree& operator=(BPlusTree&&) = delete;
+
+public:
+	template<typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	void Put(NodeValType&& val)
+	{
+		if (root_ == nullptr)
+		{
+			LeafType* leaf = NewLeaf();
+			leaf->entries.Append(std::forward<NodeValType>(val));
+			root_ = head_ = tail_ = leaf;
+			size_ = 1;
+			height_ = 1;
+			return;
+		}
+
+		InnerType* path[kMaxDepth];
+		int path_index[kMaxDepth];
+		int depth = 0;
+		LeafType* leaf = FindLeaf(val, path, path_index, depth);
+
+		int pos = LowerBound(leaf, val);
+		if (pos < leaf->entries.Num() && !(val < leaf->entries[pos].val))
+		{
+			return;
+		}
+
+		for (int i = 0; i < depth; i++)
+		{
+			++path[i]->counts[path_index[i]];
+		}
+		++size_;
+
+		if (leaf->entries.Num() < LeafType::kCapacity)
+		{
+			leaf->entries.Insert(pos, std::forward<NodeValType>(val));
+			return;
+		}
+
+		// Ҷȶ԰ٲ
+		LeafType* right = NewLeaf();
+		const int half = (LeafType::kCapacity + 1) / 2;
+		leaf->entries.MoveTailTo(half, right->entries);
+		if (pos <= half)
+		{
+			leaf->entries.Insert(pos, std::forward<NodeValType>(val));
+		}
+		else
+		{
+			right->entries.Insert(pos - half, std::forward<NodeValType>(val));
+		}
+
+		right->prev = leaf;
+		right->next = leaf->next;
+		if (leaf->next != nullptr)
+		{
+			leaf->next->prev = right;
+		}
+		else
+		{
+			tail_ = right;
+		}
+		leaf->next = right;
+
+		InsertUp(path, path_index, depth, leaf, leaf->entries.Num(), RealTType(right->entries[0].val), right, right->entries.Num());
+	}
+
+	template<typename NodeValType>
+	NodeType const*const Get(NodeValType&& val) const noexcept
+	{
+		if (root_ == nullptr)
+		{
+			return nullptr;
+		}
+
+		const LeafType* leaf = FindLeaf(val);
+		int pos = LowerBound(leaf, val);
+		if (pos < leaf->entries.Num() && !(val < leaf->entries[pos].val) && val == leaf->entries[pos].val)
+		{
+			return &leaf->entries[pos];
+		}
+
+		return nullptr;
+	}
+
+	template<typename NodeValType>
+	const bool IsExists(NodeValType&& val) const noexcept
+	{
+		return Get(std::forward<NodeValType>(val)) != nullptr;
+	}
+
+	// Ҷͬһ
+	const int Height()const noexcept
+	{
+		return height_;
+	}
+
+	const bool IsBST()const noexcept
+	{
+		if (root_ == nullptr)
+		{
+			return true;
+		}
+
+		for (const LeafType* leaf = head_; leaf != nullptr; leaf = leaf->next)
+		{
+			for (int i = 0; i < leaf->entries.Num(); i++)
+			{
+				const RealTType* prev = i > 0 ? &leaf->entries[i - 1].val : (leaf->prev != nullptr ? &leaf->prev->entries[leaf->prev->entries.Num() - 1].val : nullptr);
+				if (prev != nullptr && !(*prev < leaf->entries[i].val))
+				{
+					return false;
+				}
+			}
+		}
+
+		return IsBST(root_, nullptr, nullptr);
+	}
+
+	const bool IsBalanced()const noexcept
+	{
+		return root_ == nullptr || IsBalanced(root_, height_, true);
+	}
+
+	const bool IsSizeConsistent()const noexcept
+	{
+		return root_ == nullptr ? size_ == 0 : SubtreeSize(root_) == size_;
+	}
+
+	void DelMin()
+	{
+		if (root_ == nullptr)
+		{
+			return;
+		}
+
+		InnerType* path[kMaxDepth];
+		int path_index[kMaxDepth];
+		int depth = 0;
+
+		BPlusNodeBase* node = root_;
+		while (!node->is_leaf)
+		{
+			InnerType* inner = static_cast<InnerType*>(node);
+			path[depth] = inner;
+			path_index[depth++] = 0;
+			node = inner->children[0];
+		}
+
+		EraseAt(path, path_index, depth, static_cast<LeafType*>(node), 0);
+	}
+
+	void DelMax()
+	{
+		if (root_ == nullptr)
+		{
+			return;
+		}
+
+		InnerType* path[kMaxDepth];
+		int path_index[kMaxDepth];
+		int depth = 0;
+
+		BPlusNodeBase* node = root_;
+		while (!node->is_leaf)
+		{
+			InnerType* inner = static_cast<InnerType*>(node);
+			path[depth] = inner;
+			path_index[depth++] = inner->child_num - 1;
+			node = inner->children[inner->child_num - 1];
+		}
+
+		LeafType* leaf = static_cast<LeafType*>(node);
+		EraseAt(path, path_index, depth, leaf, leaf->entries.Num() - 1);
+	}
+
+	NodeType const*const Min()const noexcept
+	{
+		if (head_ == nullptr)
+		{
+			return nullptr;
+		}
+
+		return &head_->entries[0];
+	}
+
+	NodeType const*const Max()const noexcept
+	{
+		if (tail_ == nullptr)
+		{
+			return nullptr;
+		}
+
+		return &tail_->entries[tail_->entries.Num() - 1];
+	}
+
+	NodeType const*const Select(int ranking)const noexcept
+	{
+		if (ranking < 1 || ranking > size_)
+		{
+			return nullptr;
+		}
+
+		const BPlusNodeBase* node = root_;
+		while (!node->is_leaf)
+		{
+			const InnerType* inner = static_cast<const InnerType*>(node);
+			int i = 0;
+			while (ranking > inner->counts[i])
+			{
+				ranking -= inner->counts[i];
+				++i;
+			}
+			node = inner->children[i];
+		}
+
+		return &static_cast<const LeafType*>(node)->entries[ranking - 1];
+	}
+
+	template<typename NodeValType>
+	const int Rank(NodeValType&& val)const noexcept
+	{
+		if (root_ == nullptr)
+		{
+			return 0;
+		}
+
+		int rank = 0;
+		const BPlusNodeBase* node = root_;
+		while (!node->is_leaf)
+		{
+			const InnerType* inner = static_cast<const InnerType*>(node);
+			int i = UpperBound(inner, val);
+			for (int j = 0; j < i; j++)
+			{
+				rank += inner->counts[j];
+			}
+			node = inner->children[i];
+		}
+
+		const LeafType* leaf = static_cast<const LeafType*>(node);
+		int pos = LowerBound(leaf, val);
+		if (pos < leaf->entries.Num() && !(val < leaf->entries[pos].val))
+		{
+			return rank + pos + 1;
+		}
+
+		return 0;
+	}
+
+	// RedBlackBSTһ£<=ȽϣϸСvalԪ
+	template<typename NodeValType>
+	NodeType const*const Floor(NodeValType&& val)const noexcept
+	{
+		if (root_ == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto pred = [&val](const RealTType& x) { return val <= x; };
+		const LeafType* leaf = FindFirstLeaf(pred);
+		int pos = FirstOf(leaf, pred);
+		if (pos > 0)
+		{
+			return &leaf->entries[pos - 1];
+		}
+		if (leaf->prev != nullptr)
+		{
+			return &leaf->prev->entries[leaf->prev->entries.Num() - 1];
+		}
+
+		return nullptr;
+	}
+
+	// ϸvalСԪ
+	template<typename NodeValType>
+	NodeType const*const Ceiling(NodeValType&& val)const noexcept
+	{
+		if (root_ == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto pred = [&val](const RealTType& x) { return !(x <= val); };
+		const LeafType* leaf = FindFirstLeaf(pred);
+		int pos = FirstOf(leaf, pred);
+		if (pos < leaf->entries.Num())
+		{
+			return &leaf->entries[pos];
+		}
+		if (leaf->next != nullptr)
+		{
+			return &leaf->next->entries[0];
+		}
+
+		return nullptr;
+	}
+
+	template<typename TTraversingCb>
+	void MiddleOrderWithRecursion(TTraversingCb&& fun)const noexcept
+	{
+		for (const LeafType* leaf = head_; leaf != nullptr; leaf = leaf->next)
+		{
+			for (int i = 0; i < leaf->entries.Num(); i++)
+			{
+				fun(leaf->entries[i].val);
+			}
+		}
+	}
+
+	template<typename TTraversingCb>
+	void DescendTraverse(TTraversingCb&& fun)const noexcept
+	{
+		for (const LeafType* leaf = tail_; leaf != nullptr; leaf = leaf->prev)
+		{
+			for (int i = leaf->entries.Num() - 1; i >= 0; i--)
+			{
+				fun(leaf->entries[i].val);
+			}
+		}
+	}
+
+	template<typename NodeValType>
+	void Delete(NodeValType&& val)
+	{
+		if (root_ == nullptr)
+		{
+			return;
+		}
+
+		InnerType* path[kMaxDepth];
+		int path_index[kMaxDepth];
+		int depth = 0;
+		LeafType* leaf = FindLeaf(val, path, path_index, depth);
+
+		int pos = LowerBound(leaf, val);
+		if (pos < leaf->entries.Num() && !(val < leaf->entries[pos].val) && val == leaf->entries[pos].val)
+		{
+			EraseAt(path, path_index, depth, leaf, pos);
+		}
+	}
+
+	// ϸO(N)ؽԭݻᱻ
+	template<typename TIterator>
+	void BuildFromSorted(TIterator first, TIterator last)
+	{
+		Clear();
+
+		int num = static_cast<int>(std::distance(first, last));
+		if (num == 0)
+		{
+			return;
+		}
+
+		// ÿз֣ÿڵ㶼С
+		std::vector<BPlusNodeBase*> level;
+		std::vector<int> level_counts;
+		int leaf_num = (num + LeafType::kCapacity - 1) / LeafType::kCapacity;
+		LeafType* prev = nullptr;
+		for (int i = 0; i < leaf_num; i++)
+		{
+			int entry_num = num / leaf_num + (i < num % leaf_num ? 1 : 0);
+			LeafType* leaf = NewLeaf();
+			for (int j = 0; j < entry_num; j++, ++first)
+			{
+				leaf->entries.Append(*first);
+			}
+
+			leaf->prev = prev;
+			if (prev != nullptr)
+			{
+				prev->next = leaf;
+			}
+			else
+			{
+				head_ = leaf;
+			}
+			prev = leaf;
+
+			level.push_back(leaf);
+			level_counts.push_back(entry_num);
+		}
+		tail_ = prev;
+		height_ = 1;
+
+		while (level.size() > 1)
+		{
+			std::vector<BPlusNodeBase*> upper;
+			std::vector<int> upper_counts;
+			int child_total = static_cast<int>(level.size());
+			int inner_num = (child_total + InnerType::kCapacity - 1) / InnerType::kCapacity;
+			int index = 0;
+			for (int i = 0; i < inner_num; i++)
+			{
+				int child_num = child_total / inner_num + (i < child_total % inner_num ? 1 : 0);
+				InnerType* inner = NewInner();
+				int count = 0;
+				for (int j = 0; j < child_num; j++, index++)
+				{
+					if (j > 0)
+					{
+						inner->keys.Append(MinVal(level[index]));
+					}
+					inner->children[j] = level[index];
+					inner->counts[j] = level_counts[index];
+					count += level_counts[index];
+				}
+				inner->child_num = child_num;
+
+				upper.push_back(inner);
+				upper_counts.push_back(count);
+			}
+
+			level.swap(upper);
+			level_counts.swap(upper_counts);
+			++height_;
+		}
+
+		root_ = level[0];
+		size_ = num;
+	}
+
+	// ȥؽ
+	template<typename TIterator>
+	void BuildFromUnsorted(TIterator first, TIterator last)
+	{
+		std::vector<RealTType> vals(first, last);
+		std::sort(vals.begin(), vals.end());
+		vals.erase(std::unique(vals.begin(), vals.end(), [](const RealTType& l, const RealTType& r)
+		{
+			return !(l < r) && !(r < l);
+		}), vals.end());
+
+		BuildFromSorted(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+	}
+
+	void Clear()
+	{
+		FreeNode(root_);
+		root_ = nullptr;
+		head_ = tail_ = nullptr;
+		size_ = 0;
+		height_ = 0;
+	}
+
+	const bool IsEmpty()const noexcept
+	{
+		return root_ == nullptr;
+	}
+
+	const int Size()const noexcept
+	{
+		return size_;
+	}
+
+	// ڵռõڴֽ
+	const size_t MemoryUsage()const noexcept
+	{
+		return leaf_num_ * sizeof(LeafType) + inner_num_ * sizeof(InnerType);
+	}
+
+private:
+	// СȳΪ2ʱ32intΧڵԪ
+	static const int kMaxDepth = 32;
+
+	LeafType* NewLeaf()
+	{
+		++leaf_num_;
+		return new LeafType();
+	}
+
+	InnerType* NewInner()
+	{
+		++inner_num_;
+		return new InnerType();
+	}
+
+	void DeleteNode(BPlusNodeBase* node)noexcept
+	{
+		if (node->is_leaf)
+		{
+			--leaf_num_;
+			delete static_cast<LeafType*>(node);
+		}
+		else
+		{
+			--inner_num_;
+			delete static_cast<InnerType*>(node);
+		}
+	}
+
+	void FreeNode(BPlusNodeBase* node)noexcept
+	{
+		if (node == nullptr)
+		{
+			return;
+		}
+
+		if (!node->is_leaf)
+		{
+			InnerType* inner = static_cast<InnerType*>(node);
+			for (int i = 0; i < inner->child_num; i++)
+			{
+				FreeNode(inner->children[i]);
+			}
+		}
+		DeleteNode(node);
+	}
+
+	// ҶеһСvalλ
+	template<typename NodeValType>
+	static int LowerBound(const LeafType* leaf, const NodeValType& val)noexcept
+	{
+		int low = 0;
+		int high = leaf->entries.Num();
+		while (low < high)
+		{
+			int mid = (low + high) / 2;
+			if (leaf->entries[mid].val < val)
+			{
+				low = mid + 1;
+			}
+			else
+			{
+				high = mid;
+			}
+		}
+
+		return low;
+	}
+
+	// valķָval±
+	template<typename NodeValType>
+	static int UpperBound(const InnerType* inner, const NodeValType& val)noexcept
+	{
+		int low = 0;
+		int high = inner->keys.Num();
+		while (low < high)
+		{
+			int mid = (low + high) / 2;
+			if (val < inner->keys[mid])
+			{
+				high = mid;
+			}
+			else
+			{
+				low = mid + 1;
+			}
+		}
+
+		return low;
+	}
+
+	// Ҷеһ㵥νʵλ
+	template<typename TPred>
+	static int FirstOf(const LeafType* leaf, TPred& pred)noexcept
+	{
+		int low = 0;
+		int high = leaf->entries.Num();
+		while (low < high)
+		{
+			int mid = (low + high) / 2;
+			if (pred(leaf->entries[mid].val))
+			{
+				high = mid;
+			}
+			else
+			{
+				low = mid + 1;
+			}
+		}
+
+		return low;
+	}
+
+	// ҵһνʵԪڵҶӣԪҲһҶӵĵһԪ
+	template<typename TPred>
+	const LeafType* FindFirstLeaf(TPred& pred)const noexcept
+	{
+		const BPlusNodeBase* node = root_;
+		while (!node->is_leaf)
+		{
+			const InnerType* inner = static_cast<const InnerType*>(node);
+			int low = 0;
+			int high = inner->keys.Num();
+			while (low < high)
+			{
+				int mid = (low + high) / 2;
+				if (pred(inner->keys[mid]))
+				{
+					high = mid;
+				}
+				else
+				{
+					low = mid + 1;
+				}
+			}
+			node = inner->children[low];
+		}
+
+		return static_cast<const LeafType*>(node);
+	}
+
+	template<typename NodeValType>
+	const LeafType* FindLeaf(const NodeValType& val)const noexcept
+	{
+		const BPlusNodeBase* node = root_;
+		while (!node->is_leaf)
+		{
+			const InnerType* inner = static_cast<const InnerType*>(node);
+			node = inner->children[UpperBound(inner, val)];
+		}
+
+		return static_cast<const LeafType*>(node);
+	}
+
+	// ½ʱ¼·ϵڲڵߵ±
+	template<typename NodeValType>
+	LeafType* FindLeaf(const NodeValType& val, InnerType** path, int* path_index, int& depth)noexcept
+	{
+		BPlusNodeBase* node = root_;
+		while (!node->is_leaf)
+		{
+			InnerType* inner = static_cast<InnerType*>(node);
+			int i = UpperBound(inner, val);
+			path[depth] = inner;
+			path_index[depth++] = i;
+			node = inner->children[i];
+		}
+
+		return static_cast<LeafType*>(node);
+	}
+
+	static const RealTType& MinVal(const BPlusNodeBase* node)noexcept
+	{
+		while (!node->is_leaf)
+		{
+			node = static_cast<const InnerType*>(node)->children[0];
+		}
+
+		return static_cast<const LeafType*>(node)->entries[0].val;
+	}
+
+	static int SumCounts(const InnerType* inner)noexcept
+	{
+		int sum = 0;
+		for (int i = 0; i < inner->child_num; i++)
+		{
+			sum += inner->counts[i];
+		}
+
+		return sum;
+	}
+
+	// posָpos - 1
+	static void InsertChild(InnerType* inner, int pos, RealTType&& key, BPlusNodeBase* child, int count)
+	{
+		for (int i = inner->child_num; i > pos; i--)
+		{
+			inner->children[i] = inner->children[i - 1];
+			inner->counts[i] = inner->counts[i - 1];
+		}
+		inner->children[pos] = child;
+		inner->counts[pos] = count;
+		inner->keys.Insert(pos - 1, std::move(key));
+		++inner->child_num;
+	}
+
+	// ɾposߵķָposΪ0
+	static void RemoveChild(InnerType* inner, int pos)
+	{
+		for (int i = pos; i < inner->child_num - 1; i++)
+		{
+			inner->children[i] = inner->children[i + 1];
+			inner->counts[i] = inner->counts[i + 1];
+		}
+		inner->keys.Erase(pos - 1);
+		--inner->child_num;
+	}
+
+	// ӽڵѺҰ벿ֲ븸ڵ㣬ڵ˼Ϸ
+	void InsertUp(InnerType** path, int* path_index, int depth, BPlusNodeBase* left, int left_count, RealTType&& key, BPlusNodeBase* right, int right_count)
+	{
+		while (depth > 0)
+		{
+			InnerType* parent = path[--depth];
+			int index = path_index[depth];
+			parent->counts[index] = left_count;
+
+			if (parent->child_num < InnerType::kCapacity)
+			{
+				InsertChild(parent, index + 1, std::move(key), right, right_count);
+				return;
+			}
+
+			// ߱ǰhalfkeys[half - 1]ƣƵ½ڵ
+			InnerType* sibling = NewInner();
+			const int half = InnerType::kCapacity / 2;
+			RealTType up_key(std::move(parent->keys[half - 1]));
+			for (int i = half; i < parent->child_num; i++)
+			{
+				sibling->children[i - half] = parent->children[i];
+				sibling->counts[i - half] = parent->counts[i];
+			}
+			sibling->child_num = parent->child_num - half;
+			parent->keys.MoveTailTo(half, sibling->keys);
+			parent->keys.Erase(half - 1);
+			parent->child_num = half;
+
+			if (index + 1 <= half)
+			{
+				InsertChild(parent, index + 1, std::move(key), right, right_count);
+			}
+			else
+			{
+				InsertChild(sibling, index + 1 - half, std::move(key), right, right_count);
+			}
+
+			left = parent;
+			left_count = SumCounts(parent);
+			key = std::move(up_key);
+			right = sibling;
+			right_count = SumCounts(sibling);
+		}
+
+		// ڵѣһ
+		InnerType* root = NewInner();
+		root->children[0] = left;
+		root->counts[0] = left_count;
+		root->children[1] = right;
+		root->counts[1] = right_count;
+		root->keys.Append(std::move(key));
+		root->child_num = 2;
+		root_ = root;
+		++height_;
+	}
+
+	// ɾҶposԪأȻ¶ϴڵ
+	void EraseAt(InnerType** path, int* path_index, int depth, LeafType* leaf, int pos)
+	{
+		leaf->entries.Erase(pos);
+		for (int i = 0; i < depth; i++)
+		{
+			--path[i]->counts[path_index[i]];
+		}
+		--size_;
+
+		if (depth == 0)
+		{
+			if (leaf->entries.Num() == 0)
+			{
+				DeleteNode(leaf);
+				root_ = head_ = tail_ = nullptr;
+				height_ = 0;
+			}
+			return;
+		}
+
+		if (leaf->entries.Num() >= LeafType::kMinNum)
+		{
+			return;
+		}
+
+		RebalanceLeaf(path[depth - 1], path_index[depth - 1]);
+		for (int d = depth - 1; d > 0; d--)
+		{
+			if (path[d]->child_num >= InnerType::kMinNum)
+			{
+				return;
+			}
+			RebalanceInner(path[d - 1], path_index[d - 1]);
+		}
+
+		// ڵֻʣһʱһ
+		InnerType* root = static_cast<InnerType*>(root_);
+		if (root->child_num == 1)
+		{
+			root_ = root->children[0];
+			DeleteNode(root);
+			--height_;
+		}
+	}
+
+	void RebalanceLeaf(InnerType* parent, int index)
+	{
+		LeafType* leaf = static_cast<LeafType*>(parent->children[index]);
+
+		if (index > 0)
+		{
+			LeafType* left = static_cast<LeafType*>(parent->children[index - 1]);
+			if (left->entries.Num() > LeafType::kMinNum)
+			{
+				int last = left->entries.Num() - 1;
+				leaf->entries.Insert(0, std::move(left->entries[last]));
+				left->entries.Erase(last);
+				--parent->counts[index - 1];
+				++parent->counts[index];
+				parent->keys[index - 1] = leaf->entries[0].val;
+				return;
+			}
+		}
+
+		if (index < parent->child_num - 1)
+		{
+			LeafType* right = static_cast<LeafType*>(parent->children[index + 1]);
+			if (right->entries.Num() > LeafType::kMinNum)
+			{
+				leaf->entries.Append(std::move(right->entries[0]));
+				right->entries.Erase(0);
+				++parent->counts[index];
+				--parent->counts[index + 1];
+				parent->keys[index] = right->entries[0].val;
+				return;
+			}
+		}
+
+		MergeLeaf(parent, index > 0 ? index - 1 : index);
+	}
+
+	// index + 1ҶӲindexҶ
+	void MergeLeaf(InnerType* parent, int index)
+	{
+		LeafType* left = static_cast<LeafType*>(parent->children[index]);
+		LeafType* right = static_cast<LeafType*>(parent->children[index + 1]);
+
+		right->entries.MoveTailTo(0, left->entries);
+		left->next = right->next;
+		if (right->next != nullptr)
+		{
+			right->next->prev = left;
+		}
+		else
+		{
+			tail_ = left;
+		}
+
+		parent->counts[index] += parent->counts[index + 1];
+		RemoveChild(parent, index + 1);
+		DeleteNode(right);
+	}
+
+	void RebalanceInner(InnerType* parent, int index)
+	{
+		InnerType* node = static_cast<InnerType*>(parent->children[index]);
+
+		if (index > 0)
+		{
+			InnerType* left = static_cast<InnerType*>(parent->children[index - 1]);
+			if (left->child_num > InnerType::kMinNum)
+			{
+				int last = left->child_num - 1;
+				int moved = left->counts[last];
+				for (int i = node->child_num; i > 0; i--)
+				{
+					node->children[i] = node->children[i - 1];
+					node->counts[i] = node->counts[i - 1];
+				}
+				node->children[0] = left->children[last];
+				node->counts[0] = moved;
+				node->keys.Insert(0, std::move(parent->keys[index - 1]));
+				++node->child_num;
+
+				parent->keys[index - 1] = std::move(left->keys[last - 1]);
+				left->keys.Erase(last - 1);
+				--left->child_num;
+
+				parent->counts[index - 1] -= moved;
+				parent->counts[index] += moved;
+				return;
+			}
+		}
+
+		if (index < parent->child_num - 1)
+		{
+			InnerType* right = static_cast<InnerType*>(parent->children[index + 1]);
+			if (right->child_num > InnerType::kMinNum)
+			{
+				int moved = right->counts[0];
+				node->children[node->child_num] = right->children[0];
+				node->counts[node->child_num] = moved;
+				node->keys.Append(std::move(parent->keys[index]));
+				++node->child_num;
+
+				parent->keys[index] = std::move(right->keys[0]);
+				right->keys.Erase(0);
+				for (int i = 0; i < right->child_num - 1; i++)
+				{
+					right->children[i] = right->children[i + 1];
+					right->counts[i] = right->counts[i + 1];
+				}
+				--right->child_num;
+
+				parent->counts[index] += moved;
+				parent->counts[index + 1] -= moved;
+				return;
+			}
+		}
+
+		MergeInner(parent, index > 0 ? index - 1 : index);
+	}
+
+	// index + 1ڲڵͬڵеķָindexĽڵ
+	void MergeInner(InnerType* parent, int index)
+	{
+		InnerType* left = static_cast<InnerType*>(parent->children[index]);
+		InnerType* right = static_cast<InnerType*>(parent->children[index + 1]);
+
+		left->keys.Append(std::move(parent->keys[index]));
+		right->keys.MoveTailTo(0, left->keys);
+		for (int i = 0; i < right->child_num; i++)
+		{
+			left->children[left->child_num + i] = right->children[i];
+			left->counts[left->child_num + i] = right->counts[i];
+		}
+		left->child_num += right->child_num;
+		right->child_num = 0;
+
+		parent->counts[index] += parent->counts[index + 1];
+		RemoveChild(parent, index + 1);
+		DeleteNode(right);
+	}
+
+	const int SubtreeSize(const BPlusNodeBase* node)const noexcept
+	{
+		if (node->is_leaf)
+		{
+			return static_cast<const LeafType*>(node)->entries.Num();
+		}
+
+		const InnerType* inner = static_cast<const InnerType*>(node);
+		int sum = 0;
+		for (int i = 0; i < inner->child_num; i++)
+		{
+			int size = SubtreeSize(inner->children[i]);
+			if (size != inner->counts[i])
+			{
+				return -1;
+			}
+			sum += size;
+		}
+
+		return sum;
+	}
+
+	// ÿԪضָ֮
+	const bool IsBST(const BPlusNodeBase* node, const RealTType* min_val, const RealTType* max_val)const noexcept
+	{
+		if (node->is_leaf)
+		{
+			const LeafType* leaf = static_cast<const LeafType*>(node);
+			for (int i = 0; i < leaf->entries.Num(); i++)
+			{
+				if ((min_val != nullptr && leaf->entries[i].val < *min_val) || (max_val != nullptr && !(leaf->entries[i].val < *max_val)))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		const InnerType* inner = static_cast<const InnerType*>(node);
+		for (int i = 0; i < inner->child_num; i++)
+		{
+			const RealTType* low = i > 0 ? &inner->keys[i - 1] : min_val;
+			const RealTType* high = i < inner->child_num - 1 ? &inner->keys[i] : max_val;
+			if (!IsBST(inner->children[i], low, high))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// ҶͬǸڵ㲻С
+	const bool IsBalanced(const BPlusNodeBase* node, int level, bool is_root)const noexcept
+	{
+		if (node->is_leaf)
+		{
+			const LeafType* leaf = static_cast<const LeafType*>(node);
+			return level == 1 && (is_root || leaf->entries.Num() >= LeafType::kMinNum);
+		}
+
+		const InnerType* inner = static_cast<const InnerType*>(node);
+		if (inner->child_num < (is_root ? 2 : InnerType::kMinNum) || inner->keys.Num() != inner->child_num - 1)
+		{
+			return false;
+		}
+
+		for (int i = 0; i < inner->child_num; i++)
+		{
+			if (!IsBalanced(inner->children[i], level - 1, false))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+private:
+	BPlusNodeBase* root_;
+	LeafType* head_;
+	LeafType* tail_;
+	int size_;
+	int height_;
+	size_t leaf_num_;
+	size_t inner_num_;
+};
+
+#endif // !BPLUS_TREE_H_
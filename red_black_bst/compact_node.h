@@ -0,0 +1,71 @@
+#ifndef COMPACT_NODE_H_
+#define COMPACT_NODE_H_
+
+#include <cstdint>
+#include <utility>
+
+// սڵ㣺ӽڵǽڵе32λ±꣬ɫڵλ
+//
+// ÿԪصڴ濪64λ
+//   Node<T>        unique_ptr 16ֽ + T + int 4ֽ + bool 1ֽڣ8ֽڶ룬
+//                  ÿڵ㵥仹ҪmallocͷglibcΪ16ֽڣ
+//                  T=intʱ 32+16=48ֽڣT=Player(16ֽ)ʱ 40+16=56ֽ
+//   CompactNode<T> ± 8ֽ + ɫ 4ֽ + TTĶ
+//                  T=intʱ 16ֽڣT=Playerʱ 32ֽڣûmallocͷ
+//                  vectorڼٶһԤռ
+template<typename T>
+struct CompactNode
+{
+	CompactNode() = delete;
+
+	const static bool RED = true;
+	const static bool BLACK = false;
+
+	static const uint32_t kNullIndex = 0xFFFFFFFF;
+	static const uint32_t kColorBit = 0x80000000;
+	static const uint32_t kSizeMask = 0x7FFFFFFF;
+
+	template<typename NodeValType>
+	explicit CompactNode(NodeValType&& param) :left(kNullIndex), right(kNullIndex), size_and_color(1 | kColorBit), val(std::forward<NodeValType>(param))
+	{
+	}
+
+	const int SubNodeNum()const noexcept
+	{
+		return static_cast<int>(size_and_color & kSizeMask);
+	}
+
+	void SetSubNodeNum(int num)noexcept
+	{
+		size_and_color = (size_and_color & kColorBit) | (static_cast<uint32_t>(num) & kSizeMask);
+	}
+
+	const bool Color()const noexcept
+	{
+		return (size_and_color & kColorBit) != 0;
+	}
+
+	void SetColor(bool color)noexcept
+	{
+		size_and_color = color ? (size_and_color | kColorBit) : (size_and_color & kSizeMask);
+	}
+
+	uint32_t left;
+	uint32_t right;
+
+	// λΪɫ31λΪԸýڵΪеĽڵ
+	uint32_t size_and_color;
+
+	T val;
+};
+
+template<typename T>
+const uint32_t CompactNode<T>::kNullIndex;
+
+template<typename T>
+const uint32_t CompactNode<T>::kColorBit;
+
+template<typename T>
+const uint32_t CompactNode<T>::kSizeMask;
+
+#endif // !COMPACT_NODE_H_
@@ -0,0 +1,949 @@
+#ifndef COMPACT_TREE_H_
+#define COMPACT_TREE_H_
+
+#include "compact_node.h"
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+// ڵеӿRedBlackBSTһ£
+// ѯصĽڵָһPutBuild֮ʧЧ
+template<typename T>
+class CompactRedBlackBST
+{
+public:
+	using RealTType = std::remove_reference_t<std::decay_t<T>>;
+	using NodeType = CompactNode<RealTType>;
+
+	CompactRedBlackBST() :root_(NodeType::kNullIndex), free_head_(NodeType::kNullIndex)
+	{
+	}
+
+	~CompactRedBlackBST() = default;
+
+	CompactRedBlackBST(const CompactRedBlackBST&) = delete;
+	CompactRedBlackBST& operator=(const CompactRedBlackBST&) = delete;
+
+	CompactRedBlackBST(CompactRedBlackBST&&) = delete;
+	CompactRedBlackBST& operator=(CompactRedBlackBST&&) = delete;
+
+public:
+	template<typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	void Put(NodeValType&& val)
+	{
+		// ȱ֤½м¼±λڷ½ڵʱʧЧ
+		if (free_head_ == NodeType::kNullIndex && nodes_.size() == nodes_.capacity())
+		{
+			nodes_.reserve(nodes_.empty() ? 16 : nodes_.size() * 2);
+		}
+
+		uint32_t* path[kMaxPathLen];
+		int depth = 0;
+
+		uint32_t* slot = &root_;
+		while (*slot != NodeType::kNullIndex)
+		{
+			NodeType& node = nodes_[*slot];
+			if (val < node.val)
+			{
+				path[depth++] = slot;
+				slot = &node.left;
+			}
+			else if (node.val < val)
+			{
+				path[depth++] = slot;
+				slot = &node.right;
+			}
+			else
+			{
+				return;
+			}
+		}
+
+		*slot = NewNode(std::forward<NodeValType>(val));
+
+		FixUpAfterPut(path, depth);
+		nodes_[root_].SetColor(NodeType::BLACK);
+	}
+
+	template<typename NodeValType>
+	NodeType const*const Get(NodeValType&& val) const noexcept
+	{
+		uint32_t index = root_;
+		while (index != NodeType::kNullIndex)
+		{
+			const NodeType& node = nodes_[index];
+			if (val < node.val)
+			{
+				index = node.left;
+			}
+			else if (node.val < val)
+			{
+				index = node.right;
+			}
+			else if (val == node.val)
+			{
+				return &node;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const int Height()const noexcept
+	{
+		return Height(root_);
+	}
+
+	template<typename NodeValType>
+	const bool IsExists(NodeValType&& val) const noexcept
+	{
+		return Get(std::forward<NodeValType>(val)) != nullptr;
+	}
+
+	const bool IsBST()const noexcept
+	{
+		return IsBST(root_, nullptr, nullptr);
+	}
+
+	const bool Is23Tree()const noexcept
+	{
+		return Is23Tree(root_);
+	}
+
+	const bool IsBalanced()const noexcept
+	{
+		int black = 0;
+		uint32_t index = root_;
+		while (index != NodeType::kNullIndex)
+		{
+			if (!IsRed(index))
+			{
+				black++;
+			}
+			index = nodes_[index].left;
+		}
+		return IsBalanced(root_, black);
+	}
+
+	const bool IsSizeConsistent()const noexcept
+	{
+		return IsSizeConsistent(root_);
+	}
+
+	void DelMin()
+	{
+		if (IsEmpty())
+		{
+			return;
+		}
+
+		if (!IsRed(nodes_[root_].left) && !IsRed(nodes_[root_].right))
+		{
+			nodes_[root_].SetColor(NodeType::RED);
+		}
+
+		uint32_t* path[kMaxPathLen];
+		int depth = 0;
+		int changed_depth = kMaxPathLen;
+
+		uint32_t* slot = DescendToMin(&root_, path, depth, changed_depth);
+		FreeNode(*slot);
+		*slot = NodeType::kNullIndex;
+
+		FixUpAfterDelete(path, depth, changed_depth);
+
+		if (!IsEmpty())
+		{
+			nodes_[root_].SetColor(NodeType::BLACK);
+		}
+	}
+
+	void DelMax()
+	{
+		if (IsEmpty())
+		{
+			return;
+		}
+
+		if (!IsRed(nodes_[root_].left) && !IsRed(nodes_[root_].right))
+		{
+			nodes_[root_].SetColor(NodeType::RED);
+		}
+
+		uint32_t* path[kMaxPathLen];
+		int depth = 0;
+		int changed_depth = kMaxPathLen;
+
+		uint32_t* slot = &root_;
+		while (true)
+		{
+			if (IsRed(nodes_[*slot].left))
+			{
+				*slot = RotateRight(*slot);
+				changed_depth = std::min(changed_depth, depth);
+			}
+			if (nodes_[*slot].right == NodeType::kNullIndex)
+			{
+				break;
+			}
+			uint32_t right = nodes_[*slot].right;
+			if (!IsRed(right) && !IsRed(nodes_[right].left))
+			{
+				*slot = MoveRedRight(*slot);
+				changed_depth = std::min(changed_depth, depth);
+			}
+
+			path[depth++] = slot;
+			slot = &nodes_[*slot].right;
+		}
+		FreeNode(*slot);
+		*slot = NodeType::kNullIndex;
+
+		FixUpAfterDelete(path, depth, changed_depth);
+
+		if (!IsEmpty())
+		{
+			nodes_[root_].SetColor(NodeType::BLACK);
+		}
+	}
+
+	NodeType const*const Min()const noexcept
+	{
+		if (IsEmpty())
+		{
+			return nullptr;
+		}
+
+		uint32_t index = root_;
+		while (nodes_[index].left != NodeType::kNullIndex)
+		{
+			index = nodes_[index].left;
+		}
+
+		return &nodes_[index];
+	}
+
+	NodeType const*const Max()const noexcept
+	{
+		if (IsEmpty())
+		{
+			return nullptr;
+		}
+
+		uint32_t index = root_;
+		while (nodes_[index].right != NodeType::kNullIndex)
+		{
+			index = nodes_[index].right;
+		}
+
+		return &nodes_[index];
+	}
+
+	NodeType const*const Select(int ranking)const noexcept
+	{
+		uint32_t index = root_;
+		while (index != NodeType::kNullIndex)
+		{
+			const NodeType& node = nodes_[index];
+			int num = Size(node.left) + 1;
+			if (num > ranking)
+			{
+				index = node.left;
+			}
+			else if (num < ranking)
+			{
+				ranking -= num;
+				index = node.right;
+			}
+			else
+			{
+				return &node;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template<typename NodeValType>
+	const int Rank(NodeValType&& val)const noexcept
+	{
+		int rank = 0;
+		uint32_t index = root_;
+		while (index != NodeType::kNullIndex)
+		{
+			const NodeType& node = nodes_[index];
+			if (val < node.val)
+			{
+				index = node.left;
+			}
+			else if (node.val < val)
+			{
+				rank += Size(node.left) + 1;
+				index = node.right;
+			}
+			else
+			{
+				return rank + Size(node.left) + 1;
+			}
+		}
+
+		return 0;
+	}
+
+	template<typename NodeValType>
+	NodeType const*const Floor(NodeValType&& val)const noexcept
+	{
+		const NodeType* floor = nullptr;
+		uint32_t index = root_;
+		while (index != NodeType::kNullIndex)
+		{
+			const NodeType& node = nodes_[index];
+			if (val <= node.val)
+			{
+				index = node.left;
+			}
+			else
+			{
+				floor = &node;
+				index = node.right;
+			}
+		}
+
+		return floor;
+	}
+
+	template<typename NodeValType>
+	NodeType const*const Ceiling(NodeValType&& val)const noexcept
+	{
+		const NodeType* ceiling = nullptr;
+		uint32_t index = root_;
+		while (index != NodeType::kNullIndex)
+		{
+			const NodeType& node = nodes_[index];
+			if (node.val <= val)
+			{
+				index = node.right;
+			}
+			else
+			{
+				ceiling = &node;
+				index = node.left;
+			}
+		}
+
+		return ceiling;
+	}
+
+	template<typename TTraversingCb>
+	void MiddleOrderWithRecursion(TTraversingCb&& fun)const noexcept
+	{
+		MiddleOrderWithRecursion(root_, std::forward<TTraversingCb>(fun));
+	}
+
+	template<typename TTraversingCb>
+	void DescendTraverse(TTraversingCb&& fun)const noexcept
+	{
+		DescendTraverse(root_, std::forward<TTraversingCb>(fun));
+	}
+
+	template<typename NodeValType>
+	void Delete(NodeValType&& val)
+	{
+		if (!IsExists(std::forward<NodeValType>(val)))
+		{
+			return;
+		}
+
+		if (!IsRed(nodes_[root_].left) && !IsRed(nodes_[root_].right))
+		{
+			nodes_[root_].SetColor(NodeType::RED);
+		}
+
+		uint32_t* path[kMaxPathLen];
+		int depth = 0;
+		int changed_depth = kMaxPathLen;
+
+		uint32_t* slot = &root_;
+		while (true)
+		{
+			if (val < nodes_[*slot].val)
+			{
+				uint32_t left = nodes_[*slot].left;
+				if (left != NodeType::kNullIndex && !IsRed(left) && !IsRed(nodes_[left].left))
+				{
+					*slot = MoveRedLeft(*slot);
+					changed_depth = std::min(changed_depth, depth);
+				}
+
+				path[depth++] = slot;
+				slot = &nodes_[*slot].left;
+				continue;
+			}
+
+			if (IsRed(nodes_[*slot].left))
+			{
+				*slot = RotateRight(*slot);
+				changed_depth = std::min(changed_depth, depth);
+			}
+			if (val == nodes_[*slot].val && nodes_[*slot].right == NodeType::kNullIndex)
+			{
+				break;
+			}
+			uint32_t right = nodes_[*slot].right;
+			if (right != NodeType::kNullIndex && !IsRed(right) && !IsRed(nodes_[right].left))
+			{
+				*slot = MoveRedRight(*slot);
+				changed_depth = std::min(changed_depth, depth);
+			}
+
+			if (val == nodes_[*slot].val)
+			{
+				// еСֵ棬תΪɾеСڵ
+				uint32_t index = *slot;
+				path[depth++] = slot;
+				slot = DescendToMin(&nodes_[index].right, path, depth, changed_depth);
+				nodes_[index].val = std::move(nodes_[*slot].val);
+				break;
+			}
+
+			path[depth++] = slot;
+			slot = &nodes_[*slot].right;
+		}
+		FreeNode(*slot);
+		*slot = NodeType::kNullIndex;
+
+		FixUpAfterDelete(path, depth, changed_depth);
+
+		if (!IsEmpty())
+		{
+			nodes_[root_].SetColor(NodeType::BLACK);
+		}
+	}
+
+	// ϸO(N)ؽԭݻᱻ
+	template<typename TIterator>
+	void BuildFromSorted(TIterator first, TIterator last)
+	{
+		Clear();
+
+		int num = static_cast<int>(std::distance(first, last));
+		if (num == 0)
+		{
+			return;
+		}
+
+		int black_height = 0;
+		while ((2LL << black_height) - 1 <= num)
+		{
+			++black_height;
+		}
+
+		nodes_.reserve(num);
+		root_ = Build(first, num, black_height);
+	}
+
+	// ȥؽ
+	template<typename TIterator>
+	void BuildFromUnsorted(TIterator first, TIterator last)
+	{
+		std::vector<RealTType> vals(first, last);
+		std::sort(vals.begin(), vals.end());
+		vals.erase(std::unique(vals.begin(), vals.end(), [](const RealTType& l, const RealTType& r)
+		{
+			return !(l < r) && !(r < l);
+		}), vals.end());
+
+		BuildFromSorted(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+	}
+
+	void Clear()
+	{
+		nodes_.clear();
+		root_ = NodeType::kNullIndex;
+		free_head_ = NodeType::kNullIndex;
+	}
+
+	void Reserve(int num)
+	{
+		nodes_.reserve(num);
+	}
+
+	const bool IsEmpty()const noexcept
+	{
+		return root_ == NodeType::kNullIndex;
+	}
+
+	const int Size()const noexcept
+	{
+		return Size(root_);
+	}
+
+	NodeType const*const GetRoot()const noexcept
+	{
+		if (IsEmpty())
+		{
+			return nullptr;
+		}
+		return &nodes_[root_];
+	}
+
+	// ڵռõֽвλԤ
+	const size_t MemoryUsage()const noexcept
+	{
+		return nodes_.capacity() * sizeof(NodeType);
+	}
+
+private:
+	template<typename NodeValType>
+	uint32_t NewNode(NodeValType&& val)
+	{
+		if (free_head_ == NodeType::kNullIndex)
+		{
+			nodes_.emplace_back(std::forward<NodeValType>(val));
+			return static_cast<uint32_t>(nodes_.size() - 1);
+		}
+
+		uint32_t index = free_head_;
+		NodeType& node = nodes_[index];
+		free_head_ = node.left;
+
+		node.val = std::forward<NodeValType>(val);
+		node.left = NodeType::kNullIndex;
+		node.right = NodeType::kNullIndex;
+		node.size_and_color = 1 | NodeType::kColorBit;
+
+		return index;
+	}
+
+	// вλͨleft
+	void FreeNode(uint32_t index)noexcept
+	{
+		nodes_[index].left = free_head_;
+		free_head_ = index;
+	}
+
+	const int Height(uint32_t index)const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return 0;
+		}
+
+		int left_height = Height(nodes_[index].left);
+		int right_height = Height(nodes_[index].right);
+
+		return 1 + (left_height >= right_height ? left_height : right_height);
+	}
+
+	const bool IsBST(uint32_t index, const RealTType* min_val, const RealTType* max_val)const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return true;
+		}
+
+		const NodeType& node = nodes_[index];
+		if (min_val != nullptr && (*min_val) >= node.val)
+		{
+			return false;
+		}
+		if (max_val != nullptr && node.val >= (*max_val))
+		{
+			return false;
+		}
+
+		return IsBST(node.left, min_val, &node.val) && IsBST(node.right, &node.val, max_val);
+	}
+
+	const bool Is23Tree(uint32_t index) const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return true;
+		}
+		if (IsRed(nodes_[index].right))
+		{
+			return false;
+		}
+		if (index != root_ && IsRed(index) && IsRed(nodes_[index].left))
+		{
+			return false;
+		}
+
+		return Is23Tree(nodes_[index].left) && Is23Tree(nodes_[index].right);
+	}
+
+	const bool IsBalanced(uint32_t index, int black) const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return black == 0;
+		}
+		if (!IsRed(index))
+		{
+			black--;
+		}
+		return IsBalanced(nodes_[index].left, black) && IsBalanced(nodes_[index].right, black);
+	}
+
+	const bool IsSizeConsistent(uint32_t index) const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return true;
+		}
+
+		const NodeType& node = nodes_[index];
+		if (node.SubNodeNum() != Size(node.left) + Size(node.right) + 1)
+		{
+			return false;
+		}
+
+		return IsSizeConsistent(node.left) && IsSizeConsistent(node.right);
+	}
+
+	template<typename TTraversingCb>
+	void DescendTraverse(uint32_t index, TTraversingCb&& fun)const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return;
+		}
+
+		DescendTraverse(nodes_[index].right, std::forward<TTraversingCb>(fun));
+		fun(nodes_[index].val);
+		DescendTraverse(nodes_[index].left, std::forward<TTraversingCb>(fun));
+	}
+
+	template<typename TTraversingCb>
+	void MiddleOrderWithRecursion(uint32_t index, TTraversingCb&& fun)const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return;
+		}
+
+		MiddleOrderWithRecursion(nodes_[index].left, std::forward<TTraversingCb>(fun));
+		fun(nodes_[index].val);
+		MiddleOrderWithRecursion(nodes_[index].right, std::forward<TTraversingCb>(fun));
+	}
+
+	template<typename TIterator>
+	uint32_t Build(TIterator& it, int num, int black_height)
+	{
+		if (num == 0)
+		{
+			return NodeType::kNullIndex;
+		}
+
+		long long sub_max = 1;
+		for (int i = 1; i < black_height; ++i)
+		{
+			sub_max *= 3;
+		}
+		sub_max -= 1;
+
+		if (num - 1 <= 2 * sub_max)
+		{
+			int left_num = (num - 1) / 2;
+
+			uint32_t left = Build(it, left_num, black_height - 1);
+			uint32_t index = NewNode(*it);
+			++it;
+			uint32_t right = Build(it, num - 1 - left_num, black_height - 1);
+
+			NodeType& node = nodes_[index];
+			node.left = left;
+			node.right = right;
+			node.SetSubNodeNum(num);
+			node.SetColor(NodeType::BLACK);
+
+			return index;
+		}
+
+		int left_num = (num - 2) / 3;
+		int middle_num = (num - 2 - left_num) / 2;
+
+		uint32_t left = Build(it, left_num, black_height - 1);
+		uint32_t red_index = NewNode(*it);
+		++it;
+		uint32_t middle = Build(it, middle_num, black_height - 1);
+		uint32_t index = NewNode(*it);
+		++it;
+		uint32_t right = Build(it, num - 2 - left_num - middle_num, black_height - 1);
+
+		NodeType& red_node = nodes_[red_index];
+		red_node.left = left;
+		red_node.right = middle;
+		red_node.SetSubNodeNum(left_num + middle_num + 1);
+		red_node.SetColor(NodeType::RED);
+
+		NodeType& node = nodes_[index];
+		node.left = red_index;
+		node.right = right;
+		node.SetSubNodeNum(num);
+		node.SetColor(NodeType::BLACK);
+
+		return index;
+	}
+
+	const bool IsRed(uint32_t index)const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return false;
+		}
+
+		return nodes_[index].Color() == NodeType::RED;
+	}
+
+	const int Size(uint32_t index)const noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return 0;
+		}
+
+		return nodes_[index].SubNodeNum();
+	}
+
+	uint32_t RotateRight(uint32_t index)noexcept
+	{
+		if (index == NodeType::kNullIndex || !IsRed(nodes_[index].left))
+		{
+			return index;
+		}
+
+		NodeType& node = nodes_[index];
+		uint32_t tmp_index = node.left;
+		NodeType& tmp = nodes_[tmp_index];
+
+		node.left = tmp.right;
+		tmp.right = index;
+		tmp.SetSubNodeNum(node.SubNodeNum());
+		node.SetSubNodeNum(Size(node.left) + Size(node.right) + 1);
+		tmp.SetColor(node.Color());
+		node.SetColor(NodeType::RED);
+
+		return tmp_index;
+	}
+
+	uint32_t RotateLeft(uint32_t index)noexcept
+	{
+		if (index == NodeType::kNullIndex || !IsRed(nodes_[index].right))
+		{
+			return index;
+		}
+
+		NodeType& node = nodes_[index];
+		uint32_t tmp_index = node.right;
+		NodeType& tmp = nodes_[tmp_index];
+
+		node.right = tmp.left;
+		tmp.left = index;
+		tmp.SetSubNodeNum(node.SubNodeNum());
+		node.SetSubNodeNum(Size(node.left) + Size(node.right) + 1);
+		tmp.SetColor(node.Color());
+		node.SetColor(NodeType::RED);
+
+		return tmp_index;
+	}
+
+	void FlipColor(uint32_t index)noexcept
+	{
+		if (index == NodeType::kNullIndex)
+		{
+			return;
+		}
+
+		NodeType& node = nodes_[index];
+		if (node.left == NodeType::kNullIndex || node.right == NodeType::kNullIndex)
+		{
+			return;
+		}
+
+		if ((!IsRed(index) && IsRed(node.left) && IsRed(node.right)) ||
+			(IsRed(index) && !IsRed(node.left) && !IsRed(node.right)))
+		{
+			node.SetColor(!node.Color());
+			nodes_[node.left].SetColor(!nodes_[node.left].Color());
+			nodes_[node.right].SetColor(!nodes_[node.right].Color());
+		}
+	}
+
+	// Ƿ˽ṹɫ
+	const bool Balance(uint32_t& index)
+	{
+		bool changed = false;
+
+		if (IsRed(nodes_[index].right))
+		{
+			index = RotateLeft(index);
+			changed = true;
+		}
+
+		uint32_t left = nodes_[index].left;
+		if (IsRed(left) && IsRed(nodes_[left].left))
+		{
+			index = RotateRight(index);
+			changed = true;
+		}
+
+		if (IsRed(nodes_[index].left) && IsRed(nodes_[index].right))
+		{
+			FlipColor(index);
+			changed = true;
+		}
+
+		return changed;
+	}
+
+	uint32_t MoveRedLeft(uint32_t index)
+	{
+		NodeType& node = nodes_[index];
+		if (node.left == NodeType::kNullIndex)
+		{
+			return index;
+		}
+		if (!(IsRed(index) && !IsRed(node.left) && !IsRed(nodes_[node.left].left)))
+		{
+			return index;
+		}
+
+		FlipColor(index);
+		if (node.right != NodeType::kNullIndex && IsRed(nodes_[node.right].left))
+		{
+			node.right = RotateRight(node.right);
+			index = RotateLeft(index);
+			FlipColor(index);
+		}
+
+		return index;
+	}
+
+	uint32_t MoveRedRight(uint32_t index)
+	{
+		NodeType& node = nodes_[index];
+		if (node.right == NodeType::kNullIndex)
+		{
+			return index;
+		}
+		if (!(IsRed(index) && !IsRed(node.right) && !IsRed(nodes_[node.right].left)))
+		{
+			return index;
+		}
+
+		FlipColor(index);
+		if (node.left != NodeType::kNullIndex && IsRed(nodes_[node.left].left))
+		{
+			index = RotateRight(index);
+			FlipColor(index);
+		}
+
+		return index;
+	}
+
+	void FixUpAfterPut(uint32_t** path, int depth)
+	{
+		int i = depth - 1;
+		for (; i >= 0; --i)
+		{
+			uint32_t& index = *path[i];
+			nodes_[index].SetSubNodeNum(nodes_[index].SubNodeNum() + 1);
+
+			if (IsRed(nodes_[index].right) && !IsRed(nodes_[index].left))
+			{
+				index = RotateLeft(index);
+			}
+
+			uint32_t left = nodes_[index].left;
+			if (IsRed(left) && IsRed(nodes_[left].left))
+			{
+				index = RotateRight(index);
+			}
+
+			if (IsRed(nodes_[index].left) && IsRed(nodes_[index].right))
+			{
+				FlipColor(index);
+			}
+
+			if (!IsRed(index))
+			{
+				--i;
+				break;
+			}
+		}
+
+		for (; i >= 0; --i)
+		{
+			NodeType& node = nodes_[*path[i]];
+			node.SetSubNodeNum(node.SubNodeNum() + 1);
+		}
+	}
+
+	uint32_t* DescendToMin(uint32_t* slot, uint32_t** path, int& depth, int& changed_depth)
+	{
+		while (nodes_[*slot].left != NodeType::kNullIndex)
+		{
+			uint32_t left = nodes_[*slot].left;
+			if (!IsRed(left) && !IsRed(nodes_[left].left))
+			{
+				*slot = MoveRedLeft(*slot);
+				changed_depth = std::min(changed_depth, depth);
+			}
+
+			path[depth++] = slot;
+			slot = &nodes_[*slot].left;
+		}
+
+		return slot;
+	}
+
+	void FixUpAfterDelete(uint32_t** path, int depth, int changed_depth)
+	{
+		changed_depth = std::min(changed_depth, depth);
+
+		for (int i = depth - 1; i >= 0; --i)
+		{
+			uint32_t& index = *path[i];
+			nodes_[index].SetSubNodeNum(nodes_[index].SubNodeNum() - 1);
+
+			if (i + 2 >= changed_depth && Balance(index))
+			{
+				changed_depth = std::min(changed_depth, i);
+			}
+		}
+	}
+
+private:
+	static const int kMaxPathLen = 128;
+
+	std::vector<NodeType> nodes_;
+	uint32_t root_;
+	// вλͷ
+	uint32_t free_head_;
+};
+
+template<>
+class CompactRedBlackBST<float> {};
+
+template<>
+class CompactRedBlackBST<double> {};
+
+#endif // !COMPACT_TREE_H_
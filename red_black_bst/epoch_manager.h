@@ -0,0 +1,103 @@
+#ifndef EPOCH_MANAGER_H_
+#define EPOCH_MANAGER_H_
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <limits>
+
+// epochڴ
+// ߽ʱѵǰȫepochǼǵһλ˳ʱ㣻д߷°汾ƽȫepoch
+// ĳepochݵĽڵ㣬ֻееǼеĶepochʱͷ
+class EpochManager
+{
+public:
+	// ͬʱǼǵĶޣʱĶȴղ
+	static const int kMaxSlotNum = 64;
+
+	EpochManager() :global_epoch_(1)
+	{
+		for (auto& slot : slots_)
+		{
+			slot.epoch.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	EpochManager(const EpochManager&) = delete;
+	EpochManager& operator=(const EpochManager&) = delete;
+
+	// ߵǼǣռõĲλÿ߳ʹԼĲλ֮ͬһ
+	int Enter()noexcept
+	{
+		const int start = ThreadSlotHint();
+		for (int i = 0; ; i++)
+		{
+			int index = (start + i) % kMaxSlotNum;
+			std::atomic<uint64_t>& epoch = slots_[index].epoch;
+
+			uint64_t expected = 0;
+			if (epoch.load(std::memory_order_relaxed) == 0 &&
+				epoch.compare_exchange_strong(expected, global_epoch_.load(std::memory_order_acquire), std::memory_order_seq_cst))
+			{
+				return index;
+			}
+
+			if (i != 0 && i % kMaxSlotNum == 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void Exit(int slot)noexcept
+	{
+		slots_[slot].epoch.store(0, std::memory_order_release);
+	}
+
+	// °汾֮ãݵĽڵepoch
+	uint64_t Advance()noexcept
+	{
+		return global_epoch_.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	// ǼеĶߵСepochûжʱֵ
+	uint64_t MinActiveEpoch()const noexcept
+	{
+		uint64_t min_epoch = std::numeric_limits<uint64_t>::max();
+		for (const auto& slot : slots_)
+		{
+			uint64_t epoch = slot.epoch.load(std::memory_order_seq_cst);
+			if (epoch != 0 && epoch < min_epoch)
+			{
+				min_epoch = epoch;
+			}
+		}
+
+		return min_epoch;
+	}
+
+private:
+	static int ThreadSlotHint()noexcept
+	{
+		static std::atomic<int> next_hint(0);
+		static thread_local int hint = next_hint.fetch_add(1, std::memory_order_relaxed) % kMaxSlotNum;
+
+		return hint;
+	}
+
+private:
+	static const int kCacheLineSize = 64;
+
+	// ÿλռһ
+	struct Slot
+	{
+		std::atomic<uint64_t> epoch;
+		char padding[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+	};
+
+	std::atomic<uint64_t> global_epoch_;
+	char padding_[kCacheLineSize - sizeof(std::atomic<uint64_t>)];
+	Slot slots_[kMaxSlotNum];
+};
+
+#endif // !EPOCH_MANAGER_H_
@@ -0,0 +1,25 @@
+#ifndef FROZEN_NODE_H_
+#define FROZEN_NODE_H_
+
+#include <utility>
+
+// ŵԪأNodeһͨ->valȡֵ
+template<typename T>
+struct FrozenEntry
+{
+	FrozenEntry() = delete;
+
+	template<typename NodeValType>
+	explicit FrozenEntry(NodeValType&& param) :val(std::forward<NodeValType>(param))
+	{
+	}
+
+	FrozenEntry(const FrozenEntry&) = default;
+	FrozenEntry(FrozenEntry&&) = default;
+	FrozenEntry& operator=(const FrozenEntry&) = default;
+	FrozenEntry& operator=(FrozenEntry&&) = default;
+
+	T val;
+};
+
+#endif // !FROZEN_NODE_H_
@@ -0,0 +1,305 @@
+#ifndef FROZEN_TREE_H_
+#define FROZEN_TREE_H_
+
+#include "frozen_node.h"
+
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <xmmintrin.h>
+#endif
+
+// ֻ򼯺ϣRedBlackBST::Freeze()ɣʺϺٱ䶯ѯƵа
+// Ԫذentries_УSelectֱӰ±ȡRankԪеλã
+// õkeyⰴEytzingerBFS˳ţkλõҺ2k2k+1
+// ½ûз֧ǰԤȡ֮keyߵÿһ㲻һĻȱʧ
+template<typename T, typename TCompare = std::less<std::remove_reference_t<std::decay_t<T>>>>
+class FrozenRedBlackBST
+{
+public:
+	using RealTType = std::remove_reference_t<std::decay_t<T>>;
+	using NodeType = FrozenEntry<RealTType>;
+	using CompareType = TCompare;
+
+	explicit FrozenRedBlackBST(const TCompare& compare = TCompare()) :compare_(compare)
+	{
+	}
+
+	// ϸ乹
+	template<typename TIterator>
+	FrozenRedBlackBST(TIterator first, TIterator last, const TCompare& compare = TCompare()) :compare_(compare)
+	{
+		for (; first != last; ++first)
+		{
+			entries_.emplace_back(*first);
+		}
+		entries_.shrink_to_fit();
+
+		const int num = Size();
+		if (num == 0)
+		{
+			return;
+		}
+
+		// ±0ãռλ
+		keys_.assign(num + 1, entries_[0].val);
+		ranks_.assign(num + 1, 0);
+		Layout(0, 1);
+	}
+
+	FrozenRedBlackBST(const FrozenRedBlackBST&) = delete;
+	FrozenRedBlackBST& operator=(const FrozenRedBlackBST&) = delete;
+
+	FrozenRedBlackBST(FrozenRedBlackBST&&) = default;
+	FrozenRedBlackBST& operator=(FrozenRedBlackBST&&) = default;
+
+public:
+	template<typename NodeValType>
+	NodeType const*const Get(const NodeValType& val)const noexcept
+	{
+		const int index = Search([this, &val](const RealTType& key) { return compare_(key, val); });
+		if (index < Size() && IsEqual(val, entries_[index].val))
+		{
+			return &entries_[index];
+		}
+
+		return nullptr;
+	}
+
+	template<typename NodeValType>
+	const bool IsExists(const NodeValType& val)const noexcept
+	{
+		return Get(val) != nullptr;
+	}
+
+	// RedBlackBST::Rankһ£1ʼvalʱ0
+	template<typename NodeValType>
+	const int Rank(const NodeValType& val)const noexcept
+	{
+		// ֱӱȽ½ʱѾkeyٷentries_
+		const size_t k = SearchSlot([this, &val](const RealTType& key) { return compare_(key, val); });
+		if (k != 0 && !compare_(val, keys_[k]))
+		{
+			return ranks_[k] + 1;
+		}
+
+		return 0;
+	}
+
+	template<typename NodeValType>
+	const int CountLess(const NodeValType& val)const noexcept
+	{
+		return Search([this, &val](const RealTType& key) { return compare_(key, val); });
+	}
+
+	template<typename NodeValType>
+	const int CountLessEqual(const NodeValType& val)const noexcept
+	{
+		return Search([this, &val](const RealTType& key) { return !compare_(val, key); });
+	}
+
+	NodeType const*const Select(int ranking)const noexcept
+	{
+		if (ranking < 1 || ranking > Size())
+		{
+			return nullptr;
+		}
+
+		return &entries_[ranking - 1];
+	}
+
+	// RedBlackBST::Floorһ£ȡϸСvalԪ
+	template<typename NodeValType>
+	NodeType const*const Floor(const NodeValType& val)const noexcept
+	{
+		const int index = Search([this, &val](const RealTType& key) { return !LessEqual(val, key); });
+
+		return index > 0 ? &entries_[index - 1] : nullptr;
+	}
+
+	// RedBlackBST::Ceilingһ£ȡϸvalСԪ
+	template<typename NodeValType>
+	NodeType const*const Ceiling(const NodeValType& val)const noexcept
+	{
+		const int index = Search([this, &val](const RealTType& key) { return LessEqual(key, val); });
+
+		return index < Size() ? &entries_[index] : nullptr;
+	}
+
+	NodeType const*const Min()const noexcept
+	{
+		return Select(1);
+	}
+
+	NodeType const*const Max()const noexcept
+	{
+		return Select(Size());
+	}
+
+	template<typename TTraversingCb>
+	void MiddleOrderWithRecursion(TTraversingCb&& fun)const noexcept
+	{
+		for (const auto& entry : entries_)
+		{
+			fun(entry.val);
+		}
+	}
+
+	template<typename TTraversingCb>
+	void DescendTraverse(TTraversingCb&& fun)const noexcept
+	{
+		for (auto it = entries_.rbegin(); it != entries_.rend(); ++it)
+		{
+			fun(it->val);
+		}
+	}
+
+	const bool IsEmpty()const noexcept
+	{
+		return entries_.empty();
+	}
+
+	const int Size()const noexcept
+	{
+		return static_cast<int>(entries_.size());
+	}
+
+	const size_t MemoryUsage()const noexcept
+	{
+		return entries_.capacity() * sizeof(NodeType) + keys_.capacity() * sizeof(RealTType) + ranks_.capacity() * sizeof(int);
+	}
+
+private:
+	// ѵindexԪطŵEytzinger±kλ
+	int Layout(int index, int k)
+	{
+		if (k <= Size())
+		{
+			index = Layout(index, 2 * k);
+			keys_[k] = entries_[index].val;
+			ranks_[k] = index;
+			++index;
+			index = Layout(index, 2 * k + 1);
+		}
+
+		return index;
+	}
+
+	// صһʹgo_rightΪfalseԪе±꣬ΪtrueʱSize()
+	// go_righttruefalse
+	template<typename TGoRight>
+	int Search(TGoRight&& go_right)const noexcept
+	{
+		const size_t k = SearchSlot(std::forward<TGoRight>(go_right));
+
+		return k == 0 ? Size() : ranks_[k];
+	}
+
+	// ͬSearchصEytzinger±꣬Ϊtrueʱ0
+	template<typename TGoRight>
+	size_t SearchSlot(TGoRight&& go_right)const noexcept
+	{
+		const size_t num = entries_.size();
+		const RealTType* keys = keys_.data();
+
+		size_t k = 1;
+		while (k <= num)
+		{
+			// һзŵkPrefetchStridekeyʱk¼ĺkeys[k * kPrefetchStride]ʼͬһ
+			if (k * kPrefetchStride <= num)
+			{
+				Prefetch(keys + k * kPrefetchStride);
+			}
+			k = 2 * k + (go_right(keys[k]) ? 1 : 0);
+		}
+
+		// һߵλþǽȥĩβ1ߣԼһ
+		k >>= CountTrailingOnes(k) + 1;
+
+		return k;
+	}
+
+	static void Prefetch(const void* addr)noexcept
+	{
+#if defined(__GNUC__)
+		__builtin_prefetch(addr);
+#elif defined(_MSC_VER)
+		_mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
+#endif
+	}
+
+	static int CountTrailingOnes(size_t k)noexcept
+	{
+#if defined(__GNUC__)
+		return __builtin_ctzll(~static_cast<unsigned long long>(k));
+#elif defined(_MSC_VER) && defined(_WIN64)
+		unsigned long index = 0;
+		_BitScanForward64(&index, ~static_cast<unsigned long long>(k));
+		return static_cast<int>(index);
+#else
+		int num = 0;
+		while (k & 1)
+		{
+			k >>= 1;
+			++num;
+		}
+		return num;
+#endif
+	}
+
+	// ͬ͵ֵTԼ==RedBlackBSTһ
+	const bool IsEqual(const RealTType& key, const RealTType& val)const noexcept
+	{
+		return key == val;
+	}
+
+	template<typename TKey>
+	const bool IsEqual(const TKey& key, const RealTType& val)const noexcept
+	{
+		return !compare_(key, val) && !compare_(val, key);
+	}
+
+	// ĬϱȽͬ͵ֵTԼ<=ɱȽƳ
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right)const noexcept
+	{
+		return LessEqual(left, right, std::integral_constant<bool,
+			std::is_same<TCompare, std::less<RealTType>>::value && std::is_same<TLeft, RealTType>::value && std::is_same<TRight, RealTType>::value>());
+	}
+
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::true_type)const noexcept
+	{
+		return left <= right;
+	}
+
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::false_type)const noexcept
+	{
+		return !compare_(right, left);
+	}
+
+private:
+	static const size_t kCacheLineSize = 64;
+	static const size_t kPrefetchStride = sizeof(RealTType) >= kCacheLineSize ? 1 :
+		(kCacheLineSize / sizeof(RealTType) >= 16 ? 16 : (kCacheLineSize / sizeof(RealTType) >= 8 ? 8 : (kCacheLineSize / sizeof(RealTType) >= 4 ? 4 : 2)));
+
+	TCompare compare_;
+	std::vector<NodeType> entries_;
+	std::vector<RealTType> keys_;
+	std::vector<int> ranks_;
+};
+
+template<typename T, typename TCompare>
+const size_t FrozenRedBlackBST<T, TCompare>::kCacheLineSize;
+
+template<typename T, typename TCompare>
+const size_t FrozenRedBlackBST<T, TCompare>::kPrefetchStride;
+
+#endif // !FROZEN_TREE_H_
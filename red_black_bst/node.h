@@ -1,25 +1,35 @@
 #ifndef NODE_H_
 #define NODE_H_
 
+#include "node_allocator.h"
+#include "augment.h"
+
 #include <memory>
+#include <type_traits>
 
-template<typename T>
-struct Node
+// ۺֵaugment.hڻУۺʱΪ
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator, typename TAugment = NoAugment<T>>
+struct Node :NodeAugment<TAugment>
 {
+	using UniqueNodeType = std::unique_ptr<Node, typename TAllocator<Node>::Deleter>;
+
 	Node() = delete;
 	Node(const Node&) = delete;
 	Node& operator=(const Node&) = delete;
 
 	const static bool RED = true;
 	const static bool BLACK = false;
+	// ֵ;ۺֵҪʱڵؿ鶪ڵ
+	const static bool TRIVIALLY_DISCARDABLE = std::is_trivially_destructible<T>::value &&
+		std::is_trivially_destructible<NodeAugment<TAugment>>::value;
 
 	template<typename NodeValType>
 	explicit Node(NodeValType&& param) :left(nullptr), right(nullptr), val(std::forward<NodeValType>(param)), sub_node_num(1),color(RED)
 	{
 	}
 
-	std::unique_ptr<Node<T>> left;
-	std::unique_ptr<Node<T>> right;
+	UniqueNodeType left;
+	UniqueNodeType right;
 
 	T val;
 
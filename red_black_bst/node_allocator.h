@@ -0,0 +1,202 @@
+#ifndef NODE_ALLOCATOR_H_
+#define NODE_ALLOCATOR_H_
+
+#include "tree_stats.h"
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// ĬϽڵÿڵ㵥һnew/delete
+template<typename TNode>
+class HeapNodeAllocator
+{
+public:
+	struct Deleter
+	{
+		void operator()(TNode* node)const noexcept
+		{
+			TREE_STATS_INC(node_free);
+			delete node;
+		}
+	};
+
+	using UniqueNodeType = std::unique_ptr<TNode, Deleter>;
+
+	template<typename... Args>
+	UniqueNodeType New(Args&&... args)
+	{
+		++sys_alloc_num_;
+		TREE_STATS_INC(node_alloc);
+		return UniqueNodeType(new TNode(std::forward<Args>(args)...));
+	}
+
+	// ʱͬһͷ
+	void Free(UniqueNodeType)noexcept
+	{
+	}
+
+	void Release(UniqueNodeType)noexcept
+	{
+	}
+
+	// ϵͳڴĴ
+	const size_t SysAllocNum()const noexcept
+	{
+		return sys_alloc_num_;
+	}
+
+	// ڵ㶼ȫֶѣĽڵԻͷ
+	bool operator==(const HeapNodeAllocator&)const noexcept
+	{
+		return true;
+	}
+
+	bool operator!=(const HeapNodeAllocator&)const noexcept
+	{
+		return false;
+	}
+
+private:
+	size_t sys_alloc_num_ = 0;
+};
+
+// ػڵslabϵͳڴ棬ͷŵĽڵҵϸã
+// slabһʱͳһ黹ķͬһأر̰߳ȫ
+template<typename TNode>
+class PoolNodeAllocator
+{
+public:
+	// ڵڴɳسУunique_ptrֻ
+	struct Deleter
+	{
+		void operator()(TNode* node)const noexcept
+		{
+			TREE_STATS_INC(node_free);
+			node->~TNode();
+		}
+	};
+
+	using UniqueNodeType = std::unique_ptr<TNode, Deleter>;
+
+	// ÿslabɵĽڵ
+	static const size_t kSlabNodeNum = 1024;
+
+	PoolNodeAllocator() :state_(std::make_shared<PoolState>())
+	{
+	}
+
+	template<typename... Args>
+	UniqueNodeType New(Args&&... args)
+	{
+		void* mem = state_->free_list;
+		if (mem != nullptr)
+		{
+			state_->free_list = *static_cast<void**>(mem);
+		}
+		else
+		{
+			if (state_->cursor == state_->end)
+			{
+				AllocSlab();
+			}
+			mem = state_->cursor;
+			state_->cursor += SlotSize();
+		}
+
+		TREE_STATS_INC(node_alloc);
+		return UniqueNodeType(new(mem) TNode(std::forward<Args>(args)...));
+	}
+
+	// ͬһڴһؿ
+	void Free(UniqueNodeType node)noexcept
+	{
+		if (node == nullptr)
+		{
+			return;
+		}
+
+		Free(std::move(node->left));
+		Free(std::move(node->right));
+
+		TREE_STATS_INC(node_free);
+		TNode* raw = node.release();
+		raw->~TNode();
+
+		*reinterpret_cast<void**>(raw) = state_->free_list;
+		state_->free_list = raw;
+	}
+
+	// ʱãռҽڵֵ;ۺֵʱֱӶslabͳһ黹Щڵ㲻node_free
+	void Release(UniqueNodeType root)noexcept
+	{
+		if (state_.use_count() == 1 && TNode::TRIVIALLY_DISCARDABLE)
+		{
+			root.release();
+			return;
+		}
+
+		Free(std::move(root));
+	}
+
+	const size_t SysAllocNum()const noexcept
+	{
+		return state_->slabs.size();
+	}
+
+	bool operator==(const PoolNodeAllocator& other)const noexcept
+	{
+		return state_ == other.state_;
+	}
+
+	bool operator!=(const PoolNodeAllocator& other)const noexcept
+	{
+		return state_ != other.state_;
+	}
+
+private:
+	struct PoolState
+	{
+		PoolState() = default;
+		PoolState(const PoolState&) = delete;
+		PoolState& operator=(const PoolState&) = delete;
+
+		~PoolState()
+		{
+			for (auto slab : slabs)
+			{
+				::operator delete(slab);
+			}
+		}
+
+		std::vector<void*> slabs;
+		void* free_list = nullptr;
+		char* cursor = nullptr;
+		char* end = nullptr;
+	};
+
+	static constexpr size_t SlotSize()noexcept
+	{
+		// ʱλҪָܷ룬ֽڵĶ
+		return ((sizeof(TNode) > sizeof(void*) ? sizeof(TNode) : sizeof(void*)) + alignof(TNode) - 1) / alignof(TNode) * alignof(TNode);
+	}
+
+	void AllocSlab()
+	{
+		char* slab = static_cast<char*>(::operator new(SlotSize() * kSlabNodeNum));
+		state_->slabs.push_back(slab);
+		state_->cursor = slab;
+		state_->end = slab + SlotSize() * kSlabNodeNum;
+	}
+
+private:
+	std::shared_ptr<PoolState> state_;
+};
+
+template<typename TNode>
+const size_t PoolNodeAllocator<TNode>::kSlabNodeNum;
+
+#endif // !NODE_ALLOCATOR_H_
@@ -2,18 +2,30 @@
 //
 
 #include "tree.h"
+#include "compact_tree.h"
+#include "snapshot_tree.h"
+#include "bplus_tree.h"
+#include "sharded_tree.h"
+#include "tree_file.h"
+#include "tree_journal.h"
+#include "tree_stats.h"
+#include "splay_tree.h"
 
 #include "node.h"
 
 #include <iostream>
 #include <vector>
+#include <string>
 #include <time.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <numeric>
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <random>
+#include <thread>
+#include <iterator>
 
 int g_id = 1;
 
@@ -165,6 +177,27 @@ T TestDescend(const RedBlackBST<T>& bst)
 	return T(0);
 }
 
+template<typename T>
+void TestTopAndRange(const RedBlackBST<T>& bst, int top_num, int low, int high)
+{
+	PrintFormat("TestTopAndRange");
+
+	int ranking = 0;
+	for (auto it = bst.rbegin(); it != bst.rend() && ranking < top_num; ++it)
+	{
+		++ranking;
+		std::cout << "ranking:" << ranking << " val:" << *it << std::endl;
+	}
+
+	int count = 0;
+	for (const auto& val : bst.Range(T(low), T(high)))
+	{
+		std::cout << val << " ";
+		++count;
+	}
+	std::cout << std::endl << "count in [" << low << ", " << high << "]:" << count << std::endl;
+}
+
 template<typename T>
 void TestHeight(const RedBlackBST<T>& bst)
 {
@@ -323,16 +356,953 @@ private:
 	std::time_t update_time_;
 };
 
-void UpatePlayerFightVal(RedBlackBST<Player>& bst,Player p,int val)
+// а϶λֻҪս͸ʱ䣬ѯʱعPlayer
+struct PlayerKey
 {
-	// ɾ
-	bst.Delete(p);
+	int fight_val;
+	std::time_t update_time;
+};
+
+// ͸ȽPlayer::operator<һ£սսͬʱʱǰ
+struct PlayerCompare
+{
+	using is_transparent = void;
+
+	bool operator()(const Player& l, const Player& r)const
+	{
+		return Less(l.FightVal(), l.UpdateTime(), r.FightVal(), r.UpdateTime());
+	}
+
+	bool operator()(const PlayerKey& l, const Player& r)const
+	{
+		return Less(l.fight_val, l.update_time, r.FightVal(), r.UpdateTime());
+	}
+
+	bool operator()(const Player& l, const PlayerKey& r)const
+	{
+		return Less(l.FightVal(), l.UpdateTime(), r.fight_val, r.update_time);
+	}
+
+	bool operator()(const PlayerKey& l, const PlayerKey& r)const
+	{
+		return Less(l.fight_val, l.update_time, r.fight_val, r.update_time);
+	}
 
+	// ֻսȽϣGet/RankظսһңLowerBound/FloorȰս
+	bool operator()(int l, const Player& r)const
+	{
+		return l < r.FightVal();
+	}
+
+	bool operator()(const Player& l, int r)const
+	{
+		return l.FightVal() < r;
+	}
+
+	bool operator()(int l, int r)const
+	{
+		return l < r;
+	}
+
+	static bool Less(int l_fight, std::time_t l_time, int r_fight, std::time_t r_time)
+	{
+		if (l_fight != r_fight)
+		{
+			return l_fight < r_fight;
+		}
+		return l_time > r_time;
+	}
+};
+
+// ۺʱȡҵսlong long
+struct PlayerFightVal
+{
+	long long operator()(const Player& p)const
+	{
+		return p.FightVal();
+	}
+};
+
+// idƬ޸սỻƬ
+struct PlayerShard
+{
+	size_t operator()(const Player& p)const
+	{
+		return static_cast<size_t>(p.PlayerId());
+	}
+};
+
+void UpatePlayerFightVal(RedBlackBST<Player>& bst,const Player& p,int val)
+{
 	// ʱֵ
-	p.SetFightVal(val);
+	Player new_p = p;
+	new_p.SetFightVal(val);
 
-	// 
-	bst.Put(std::move(p));
+	// ԭظд¹ҽԭڵ㣬ɾ
+	bst.UpdateKey(p, std::move(new_p));
+}
+
+// ԱɾӺUpdateKey޸սĺʱ
+void TestUpdateBenchmark(int num)
+{
+	PrintFormat("TestUpdateBenchmark");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, 1000000);
+	std::uniform_int_distribution<int> delta_dist(-50, 50);
+
+	std::vector<Player> players;
+	for (int i = 0; i < num; i++)
+	{
+		players.emplace_back(uniform_dist(e1));
+	}
+
+	RedBlackBST<Player> delete_put_bst;
+	RedBlackBST<Player> update_bst;
+	for (const auto& p : players)
+	{
+		delete_put_bst.Put(p);
+		update_bst.Put(p);
+	}
+
+	std::vector<int> deltas;
+	for (int i = 0; i < num; i++)
+	{
+		deltas.push_back(delta_dist(e1));
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < num; i++)
+	{
+		Player p = players[i];
+		delete_put_bst.Delete(p);
+		p.SetFightVal(p.FightVal() + deltas[i]);
+		delete_put_bst.Put(std::move(p));
+	}
+	auto delete_put_end = std::chrono::steady_clock::now();
+	for (int i = 0; i < num; i++)
+	{
+		UpatePlayerFightVal(update_bst, players[i], players[i].FightVal() + deltas[i]);
+	}
+	auto update_end = std::chrono::steady_clock::now();
+
+	std::cout << "delete put us:" << std::chrono::duration_cast<std::chrono::microseconds>(delete_put_end - begin).count()
+		<< " update key us:" << std::chrono::duration_cast<std::chrono::microseconds>(update_end - delete_put_end).count() << std::endl;
+	std::cout << "size:" << update_bst.Size() << " 23Tree:" << update_bst.Is23Tree() << " balanced:" << update_bst.IsBalanced()
+		<< " size correct:" << update_bst.IsSizeConsistent() << std::endl;
+}
+
+// ԱÿtickPutPutBatchдһҵĺʱ
+void TestPutBatchBenchmark(int num, int batch_num)
+{
+	PrintFormat("TestPutBatchBenchmark");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, 1000000);
+
+	std::vector<Player> players;
+	for (int i = 0; i < num; i++)
+	{
+		players.emplace_back(uniform_dist(e1));
+	}
+
+	RedBlackBST<Player> put_bst;
+	RedBlackBST<Player> batch_bst;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (const auto& p : players)
+	{
+		put_bst.Put(p);
+	}
+	auto put_end = std::chrono::steady_clock::now();
+	for (int i = 0; i < num; i += batch_num)
+	{
+		batch_bst.PutBatch(players.begin() + i, players.begin() + std::min(num, i + batch_num));
+	}
+	auto batch_end = std::chrono::steady_clock::now();
+
+	std::cout << "put us:" << std::chrono::duration_cast<std::chrono::microseconds>(put_end - begin).count()
+		<< " put batch us:" << std::chrono::duration_cast<std::chrono::microseconds>(batch_end - put_end).count() << std::endl;
+	std::cout << "size:" << batch_bst.Size() << " 23Tree:" << batch_bst.Is23Tree() << " balanced:" << batch_bst.IsBalanced()
+		<< " size correct:" << batch_bst.IsSizeConsistent() << std::endl;
+}
+
+// ԱȲͬڵ10βԼɾٲµϵͳ
+template<template<typename> class TAllocator>
+void TestAllocatorBenchmark(const char* name, int num)
+{
+	PrintFormat(name);
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, 1000000);
+
+	std::vector<Player> players;
+	players.reserve(num);
+	for (int i = 0; i < num; i++)
+	{
+		players.emplace_back(uniform_dist(e1));
+	}
+
+	RedBlackBST<Player, TAllocator> bst;
+
+	auto begin = std::chrono::steady_clock::now();
+	for (const auto& p : players)
+	{
+		bst.Put(p);
+	}
+	auto put_end = std::chrono::steady_clock::now();
+
+	size_t put_alloc_num = bst.GetAllocator().SysAllocNum();
+
+	for (const auto& p : players)
+	{
+		bst.Delete(p);
+		bst.Put(p);
+	}
+	auto churn_end = std::chrono::steady_clock::now();
+
+	auto put_us = std::chrono::duration_cast<std::chrono::microseconds>(put_end - begin).count();
+	auto churn_us = std::chrono::duration_cast<std::chrono::microseconds>(churn_end - put_end).count();
+
+	std::cout << "size:" << bst.Size() << std::endl;
+	std::cout << "put sys alloc:" << put_alloc_num << " put us:" << put_us
+		<< " put ops/s:" << (put_us > 0 ? num * 1000000LL / put_us : 0) << std::endl;
+	std::cout << "churn sys alloc:" << bst.GetAllocator().SysAllocNum() - put_alloc_num << " churn us:" << churn_us
+		<< " churn ops/s:" << (churn_us > 0 ? num * 2 * 1000000LL / churn_us : 0) << std::endl;
+}
+
+// ԱָڵͽսڵÿԪصڴԼRank/Selectĺʱ
+template<typename TTree>
+void TestLayoutBenchmark(const char* name, TTree& bst, const std::vector<Player>& players)
+{
+	PrintFormat(name);
+
+	for (const auto& p : players)
+	{
+		bst.Put(p);
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	long long sum = 0;
+	for (const auto& p : players)
+	{
+		sum += bst.Rank(p);
+	}
+	auto rank_end = std::chrono::steady_clock::now();
+	for (int i = 1; i <= bst.Size(); i++)
+	{
+		sum += bst.Select(i)->val.FightVal();
+	}
+	auto select_end = std::chrono::steady_clock::now();
+
+	std::cout << "size:" << bst.Size() << " node bytes:" << sizeof(typename TTree::NodeType) << " check sum:" << sum << std::endl;
+	std::cout << "rank us:" << std::chrono::duration_cast<std::chrono::microseconds>(rank_end - begin).count()
+		<< " select us:" << std::chrono::duration_cast<std::chrono::microseconds>(select_end - rank_end).count() << std::endl;
+}
+
+// PlayerKeyֱӲѯɾʱPlayer
+void TestTransparentLookup(int num)
+{
+	PrintFormat("TestTransparentLookup");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, 1000);
+
+	RedBlackBST<Player, HeapNodeAllocator, PlayerCompare> bst;
+	for (int i = 0; i < num; i++)
+	{
+		bst.Put(Player(uniform_dist(e1)));
+	}
+
+	const Player& target = bst.Select(num / 2)->val;
+	PlayerKey key{ target.FightVal(), target.UpdateTime() };
+	std::cout << "key fight:" << key.fight_val << " rank:" << bst.Rank(key) << " get id:" << bst.Get(key)->val.PlayerId() << std::endl;
+
+	auto floor = bst.Floor(key.fight_val);
+	std::cout << "floor of fight " << key.fight_val << ":" << (floor != nullptr ? floor->val.FightVal() : -1) << std::endl;
+
+	auto range = bst.Range(key.fight_val, key.fight_val + 50);
+	int count = std::distance(range.begin(), range.end());
+	std::cout << "fight in [" << key.fight_val << ", " << key.fight_val + 50 << "]:" << count << std::endl;
+
+	bst.Delete(key);
+	std::cout << "after delete exists:" << bst.IsExists(key) << " size:" << bst.Size() << " bst:" << bst.IsBST() << std::endl;
+}
+
+// ÿ߳дһң֮ȫSelectRankΪ㲢Ұս
+void TestShardedLeaderboard(int num, int shard_num)
+{
+	PrintFormat("TestShardedLeaderboard");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, 1000000);
+
+	std::vector<Player> players;
+	for (int i = 0; i < num; i++)
+	{
+		players.emplace_back(uniform_dist(e1));
+	}
+
+	ShardedRedBlackBST<Player, PlayerShard> sharded_bst(shard_num);
+
+	auto begin = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	for (int i = 0; i < shard_num; i++)
+	{
+		workers.emplace_back([&, i]()
+		{
+			for (int j = i; j < num; j += shard_num)
+			{
+				sharded_bst.Put(players[j]);
+			}
+		});
+	}
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+	auto put_end = std::chrono::steady_clock::now();
+
+	int mismatch_num = 0;
+	int last_fight_val = 0;
+	Player p = players[0];
+	for (int i = 1; i <= sharded_bst.Size(); i += 97)
+	{
+		if (!sharded_bst.Select(i, p) || p.FightVal() < last_fight_val || sharded_bst.Rank(p) != i)
+		{
+			++mismatch_num;
+		}
+		last_fight_val = p.FightVal();
+	}
+	auto query_end = std::chrono::steady_clock::now();
+
+	std::cout << "shard num:" << shard_num << " size:" << sharded_bst.Size() << " mismatch:" << mismatch_num << std::endl;
+	std::cout << "put us:" << std::chrono::duration_cast<std::chrono::microseconds>(put_end - begin).count()
+		<< " select and rank us:" << std::chrono::duration_cast<std::chrono::microseconds>(query_end - put_end).count() << std::endl;
+}
+
+// 󶳽а񣬶ԱȶǰRank/Floorĺʱ
+void TestFreezeBenchmark(int num)
+{
+	PrintFormat("TestFreezeBenchmark");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, 1000000);
+
+	std::vector<Player> players;
+	for (int i = 0; i < num; i++)
+	{
+		players.emplace_back(uniform_dist(e1));
+	}
+
+	RedBlackBST<Player> bst;
+	for (const auto& p : players)
+	{
+		bst.Put(p);
+	}
+	auto frozen = bst.Freeze();
+
+	long long sum = 0;
+	auto begin = std::chrono::steady_clock::now();
+	for (const auto& p : players)
+	{
+		sum += bst.Rank(p);
+		sum += bst.Floor(p) != nullptr;
+	}
+	auto tree_end = std::chrono::steady_clock::now();
+	for (const auto& p : players)
+	{
+		sum -= frozen.Rank(p);
+		sum -= frozen.Floor(p) != nullptr;
+	}
+	auto frozen_end = std::chrono::steady_clock::now();
+
+	std::cout << "size:" << frozen.Size() << " bytes per entry:" << frozen.MemoryUsage() / frozen.Size() << " check sum:" << sum << std::endl;
+	std::cout << "tree us:" << std::chrono::duration_cast<std::chrono::microseconds>(tree_end - begin).count()
+		<< " frozen us:" << std::chrono::duration_cast<std::chrono::microseconds>(frozen_end - tree_end).count() << std::endl;
+}
+
+// ԱPutؽļO(N)ؽԼֱӳļѯĺʱ
+void TestTreeFile(int num, const char* path)
+{
+	PrintFormat("TestTreeFile");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 10);
+
+	std::vector<int> vals;
+	for (int i = 0; i < num; i++)
+	{
+		vals.push_back(uniform_dist(e1));
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	RedBlackBST<int> bst;
+	for (int val : vals)
+	{
+		bst.Put(val);
+	}
+	auto put_end = std::chrono::steady_clock::now();
+
+	if (!SaveTreeFile(bst, path))
+	{
+		std::cout << "save failed" << std::endl;
+		return;
+	}
+	auto save_end = std::chrono::steady_clock::now();
+
+	RedBlackBST<int, PoolNodeAllocator> loaded_bst;
+	bool load_ok = LoadTreeFile(loaded_bst, path);
+	auto load_end = std::chrono::steady_clock::now();
+
+	MappedTree<int> mapped;
+	bool open_ok = mapped.Open(path);
+	auto open_end = std::chrono::steady_clock::now();
+
+	int mismatch_num = 0;
+	for (int i = 0; i < num; i += 101)
+	{
+		if (mapped.Rank(vals[i]) != bst.Rank(vals[i]))
+		{
+			++mismatch_num;
+		}
+	}
+
+	std::cout << "size:" << bst.Size() << " load:" << load_ok << " loaded size:" << loaded_bst.Size() << " open:" << open_ok
+		<< " mapped size:" << mapped.Size() << " rank mismatch:" << mismatch_num << std::endl;
+	std::cout << "put us:" << std::chrono::duration_cast<std::chrono::microseconds>(put_end - begin).count()
+		<< " save us:" << std::chrono::duration_cast<std::chrono::microseconds>(save_end - put_end).count()
+		<< " load us:" << std::chrono::duration_cast<std::chrono::microseconds>(load_end - save_end).count()
+		<< " open us:" << std::chrono::duration_cast<std::chrono::microseconds>(open_end - load_end).count() << std::endl;
+
+	mapped.Close();
+	std::remove(path);
+}
+
+// ޸д־´򿪣طŵõͬCheckpointֻ֮ļ
+void TestJournal(int num, const char* snapshot_path, const char* journal_path)
+{
+	PrintFormat("TestJournal");
+
+	std::remove(snapshot_path);
+	std::remove(journal_path);
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 10);
+
+	int size = 0;
+	{
+		JournaledTree<RedBlackBST<int>> journaled;
+		journaled.Open(snapshot_path, journal_path);
+
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < num; i++)
+		{
+			journaled.Put(uniform_dist(e1));
+		}
+		for (int i = 0; i < num / 10; i++)
+		{
+			journaled.Delete(uniform_dist(e1));
+		}
+		bool sync_ok = journaled.Sync();
+		auto end = std::chrono::steady_clock::now();
+
+		size = journaled.GetTree().Size();
+		std::cout << "size:" << size << " sync:" << sync_ok
+			<< " us:" << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << std::endl;
+	}
+
+	{
+		JournaledTree<RedBlackBST<int>> journaled;
+		bool open_ok = journaled.Open(snapshot_path, journal_path);
+		std::cout << "reopen:" << open_ok << " size:" << journaled.GetTree().Size() << " expected:" << size
+			<< " replayed:" << journaled.ReplayedNum() << std::endl;
+
+		bool checkpoint_ok = journaled.Checkpoint();
+		std::cout << "checkpoint:" << checkpoint_ok << std::endl;
+	}
+
+	{
+		JournaledTree<RedBlackBST<int>> journaled;
+		bool open_ok = journaled.Open(snapshot_path, journal_path);
+		std::cout << "reopen:" << open_ok << " size:" << journaled.GetTree().Size() << " expected:" << size
+			<< " replayed:" << journaled.ReplayedNum() << std::endl;
+	}
+
+	// ģCheckpointдļû־ʱǰ־Żȥٻָ
+	// UpdateKey(1, 2)طһλΪ2Ѵڶʧܣ1
+	std::remove(snapshot_path);
+	std::remove(journal_path);
+	std::vector<char> old_journal;
+	{
+		JournaledTree<RedBlackBST<int>> journaled;
+		journaled.Open(snapshot_path, journal_path);
+		journaled.Put(1);
+		journaled.UpdateKey(1, 2);
+		journaled.Sync();
+
+		std::FILE* file = std::fopen(journal_path, "rb");
+		int c = 0;
+		while (file != nullptr && (c = std::fgetc(file)) != EOF)
+		{
+			old_journal.push_back(static_cast<char>(c));
+		}
+		if (file != nullptr)
+		{
+			std::fclose(file);
+		}
+
+		journaled.Checkpoint();
+	}
+	{
+		std::FILE* file = std::fopen(journal_path, "wb");
+		std::fwrite(old_journal.data(), 1, old_journal.size(), file);
+		std::fclose(file);
+
+		JournaledTree<RedBlackBST<int>> journaled;
+		bool open_ok = journaled.Open(snapshot_path, journal_path);
+		std::cout << "crash before truncate, reopen:" << open_ok << " size:" << journaled.GetTree().Size()
+			<< " has 1:" << journaled.GetTree().IsExists(1) << " has 2:" << journaled.GetTree().IsExists(2)
+			<< " replayed:" << journaled.ReplayedNum() << std::endl;
+	}
+
+	std::remove(snapshot_path);
+	std::remove(journal_path);
+}
+
+// ߰агƴԱɾٲ
+void TestSplitAndJoin(int num)
+{
+	PrintFormat("TestSplitAndJoin");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 10);
+
+	RedBlackBST<int> bst;
+	for (int i = 0; i < num; i++)
+	{
+		bst.Put(uniform_dist(e1));
+	}
+	const int size = bst.Size();
+	const int threshold = num * 9;
+
+	auto begin = std::chrono::steady_clock::now();
+	RedBlackBST<int> higher;
+	bst.Split(threshold, higher);
+	auto split_end = std::chrono::steady_clock::now();
+
+	std::cout << "lower size:" << bst.Size() << " higher size:" << higher.Size()
+		<< " min of higher:" << (higher.IsEmpty() ? 0 : higher.Min()->val)
+		<< " balanced:" << (bst.IsBalanced() && higher.IsBalanced() && bst.Is23Tree() && higher.Is23Tree())
+		<< " size consistent:" << (bst.IsSizeConsistent() && higher.IsSizeConsistent()) << std::endl;
+
+	auto join_begin = std::chrono::steady_clock::now();
+	bool join_ok = bst.Join(higher);
+	auto join_end = std::chrono::steady_clock::now();
+
+	std::cout << "join:" << join_ok << " size:" << bst.Size() << " expected:" << size << " higher size:" << higher.Size()
+		<< " balanced:" << (bst.IsBalanced() && bst.Is23Tree()) << " size consistent:" << bst.IsSizeConsistent() << std::endl;
+
+	// ɾٲ뵽һ
+	auto naive_begin = std::chrono::steady_clock::now();
+	std::vector<int> moved(bst.LowerBound(threshold), bst.end());
+	for (int val : moved)
+	{
+		bst.Delete(val);
+		higher.Put(val);
+	}
+	auto naive_end = std::chrono::steady_clock::now();
+
+	std::cout << "split us:" << std::chrono::duration_cast<std::chrono::microseconds>(split_end - begin).count()
+		<< " join us:" << std::chrono::duration_cast<std::chrono::microseconds>(join_end - join_begin).count()
+		<< " delete and put us:" << std::chrono::duration_cast<std::chrono::microseconds>(naive_end - naive_begin).count() << std::endl;
+}
+
+// ϲаҳжûеңԱPut/Delete
+void TestSetOperations(int num)
+{
+	PrintFormat("TestSetOperations");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 2);
+
+	std::vector<int> east;
+	std::vector<int> west;
+	for (int i = 0; i < num; i++)
+	{
+		east.push_back(uniform_dist(e1));
+		west.push_back(uniform_dist(e1));
+	}
+
+	RedBlackBST<int> global;
+	RedBlackBST<int> region;
+	global.BuildFromUnsorted(east.begin(), east.end());
+	region.BuildFromUnsorted(west.begin(), west.end());
+
+	RedBlackBST<int> naive_global;
+	naive_global.BuildFromUnsorted(east.begin(), east.end());
+
+	auto begin = std::chrono::steady_clock::now();
+	global.Union(region);
+	auto union_end = std::chrono::steady_clock::now();
+	for (int val : west)
+	{
+		naive_global.Put(val);
+	}
+	auto put_end = std::chrono::steady_clock::now();
+
+	std::cout << "union size:" << global.Size() << " expected:" << naive_global.Size() << " region size:" << region.Size()
+		<< " balanced:" << (global.IsBalanced() && global.Is23Tree() && global.IsSizeConsistent()) << std::endl;
+	std::cout << "union us:" << std::chrono::duration_cast<std::chrono::microseconds>(union_end - begin).count()
+		<< " put us:" << std::chrono::duration_cast<std::chrono::microseconds>(put_end - union_end).count() << std::endl;
+
+	// eastwest
+	RedBlackBST<int> left_players;
+	RedBlackBST<int> this_season;
+	left_players.BuildFromUnsorted(east.begin(), east.end());
+	this_season.BuildFromUnsorted(west.begin(), west.end());
+
+	RedBlackBST<int> naive_left_players;
+	naive_left_players.BuildFromUnsorted(east.begin(), east.end());
+
+	begin = std::chrono::steady_clock::now();
+	left_players.Difference(this_season);
+	auto difference_end = std::chrono::steady_clock::now();
+	for (int val : west)
+	{
+		naive_left_players.Delete(val);
+	}
+	auto delete_end = std::chrono::steady_clock::now();
+
+	std::cout << "difference size:" << left_players.Size() << " expected:" << naive_left_players.Size()
+		<< " balanced:" << (left_players.IsBalanced() && left_players.Is23Tree() && left_players.IsSizeConsistent()) << std::endl;
+	std::cout << "difference us:" << std::chrono::duration_cast<std::chrono::microseconds>(difference_end - begin).count()
+		<< " delete us:" << std::chrono::duration_cast<std::chrono::microseconds>(delete_end - difference_end).count() << std::endl;
+}
+
+// ÿڵάս֮ͣǰNսֱȡԱ
+void TestAugmentedSum(int num, int top_num)
+{
+	PrintFormat("TestAugmentedSum");
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 10);
+
+	RedBlackBST<Player, HeapNodeAllocator, PlayerCompare, SumAugment<Player, PlayerFightVal>> bst;
+	std::vector<Player> players;
+	for (int i = 0; i < num; i++)
+	{
+		players.emplace_back(uniform_dist(e1));
+		bst.Put(players.back());
+	}
+
+	// ޸սۺֵȻȷ
+	for (int i = 0; i < num; i += 10)
+	{
+		Player new_player = players[i];
+		new_player.SetFightVal(uniform_dist(e1));
+		if (bst.UpdateKey(players[i], new_player))
+		{
+			players[i] = new_player;
+		}
+	}
+
+	const int size = bst.Size();
+	auto begin = std::chrono::steady_clock::now();
+	long long top_sum = bst.AggregateByRank(size - top_num + 1, size);
+	long long range_sum = bst.Aggregate(num, num * 2);
+	auto aggregate_end = std::chrono::steady_clock::now();
+
+	long long expected_top_sum = 0;
+	int ranking = 0;
+	for (auto it = bst.rbegin(); it != bst.rend() && ranking < top_num; ++it, ++ranking)
+	{
+		expected_top_sum += it->FightVal();
+	}
+	long long expected_range_sum = 0;
+	for (const auto& player : bst.Range(num, num * 2))
+	{
+		expected_range_sum += player.FightVal();
+	}
+	auto traverse_end = std::chrono::steady_clock::now();
+
+	std::cout << "top " << top_num << " sum:" << top_sum << " expected:" << expected_top_sum
+		<< " range sum:" << range_sum << " expected:" << expected_range_sum
+		<< " total:" << bst.Aggregate() << std::endl;
+	std::cout << "aggregate ns:" << std::chrono::duration_cast<std::chrono::nanoseconds>(aggregate_end - begin).count()
+		<< " traverse ns:" << std::chrono::duration_cast<std::chrono::nanoseconds>(traverse_end - aggregate_end).count() << std::endl;
+}
+
+// ʱRED_BLACK_BST_STATS׶εļδʱȫΪ0
+void TestTreeStats(int num)
+{
+	PrintFormat("TestTreeStats");
+
+	auto print = [](const char* name, const TreeStats& stats)
+	{
+		std::cout << name << " rotate_left:" << stats.rotate_left << " rotate_right:" << stats.rotate_right
+			<< " flip_color:" << stats.flip_color << " move_red_left:" << stats.move_red_left << " move_red_right:" << stats.move_red_right
+			<< " balance:" << stats.balance << " put_compare:" << stats.put_compare << " get_compare:" << stats.get_compare
+			<< " node_alloc:" << stats.node_alloc << " node_free:" << stats.node_free << std::endl;
+	};
+
+	std::cout << "enabled:" << kTreeStatsEnabled << std::endl;
+	TakeThreadTreeStats();
+
+	std::default_random_engine e1(1);
+	std::uniform_int_distribution<int> uniform_dist(1, num * 10);
+
+	RedBlackBST<int> bst;
+	for (int i = 0; i < num; i++)
+	{
+		bst.Put(uniform_dist(e1));
+	}
+	print("put", TakeThreadTreeStats());
+
+	for (int i = 0; i < num; i++)
+	{
+		bst.IsExists(uniform_dist(e1));
+	}
+	print("get", TakeThreadTreeStats());
+
+	// һ߳ϵ޸Ĳ뵱ǰ߳
+	TreeStats worker_stats;
+	std::thread worker([&worker_stats, num]()
+	{
+		RedBlackBST<int> worker_bst;
+		for (int i = 0; i < num; i++)
+		{
+			worker_bst.Put(i);
+		}
+		worker_stats = TakeThreadTreeStats();
+	});
+	worker.join();
+	print("worker sorted put", worker_stats);
+
+	while (!bst.IsEmpty())
+	{
+		bst.DelMin();
+	}
+	print("delmin", TakeThreadTreeStats());
+}
+
+// ڴڼ俴ʼȡʱİ汾
+void TestSnapshotRead(int num)
+{
+	PrintFormat("TestSnapshotRead");
+
+	SnapshotRedBlackBST<int> bst;
+	for (int i = 1; i <= num; i++)
+	{
+		bst.Put(i * 10);
+	}
+
+	{
+		auto snapshot = bst.GetSnapshot();
+
+		bst.UpdateKey(10, num * 10 + 10);
+		bst.Delete(20);
+
+		std::cout << "snapshot size:" << snapshot.Size() << " rank of 30:" << snapshot.Rank(30) << " min:" << snapshot.Min()->val << std::endl;
+		std::cout << "current size:" << bst.Size() << " rank of 30:" << bst.Rank(30) << " min:" << bst.GetSnapshot().Min()->val << std::endl;
+		std::cout << "pending reclaim:" << bst.PendingReclaimNum() << std::endl;
+	}
+
+	bst.Put(15);
+	std::cout << "pending reclaim after snapshot released:" << bst.PendingReclaimNum() << std::endl;
+}
+
+// ʱ˳дʱԱȴӸʹʾĲ룬ǱȽϿϴַ
+// һǵidǷͬһңԽµŵԽǰÿζڷε
+void TestHintedPut(int num, int band_num)
+{
+	PrintFormat("TestHintedPut");
+
+	char buf[64];
+	std::vector<std::string> append_keys;
+	for (int i = 0; i < num; i++)
+	{
+		snprintf(buf, sizeof(buf), "player/%012d", i);
+		append_keys.push_back(buf);
+	}
+
+	// ΰ˳򵽴ڰʱ䵹
+	const int band_size = num / band_num;
+	std::vector<int> bands(band_num);
+	std::iota(bands.begin(), bands.end(), 1);
+	std::shuffle(bands.begin(), bands.end(), std::default_random_engine(1));
+	std::vector<std::string> band_keys;
+	for (int band : bands)
+	{
+		for (int i = 0; i < band_size; i++)
+		{
+			snprintf(buf, sizeof(buf), "score/%08d/time/%012d", band, band_size - i);
+			band_keys.push_back(buf);
+		}
+	}
+
+	auto run = [](const char* name, const std::vector<std::string>& keys)
+	{
+		TakeThreadTreeStats();
+		RedBlackBST<std::string> put_bst;
+		auto begin = std::chrono::steady_clock::now();
+		for (const auto& key : keys)
+		{
+			put_bst.Put(key);
+		}
+		auto put_end = std::chrono::steady_clock::now();
+		const TreeStats put_stats = TakeThreadTreeStats();
+
+		RedBlackBST<std::string> hint_bst;
+		auto hint = hint_bst.end();
+		for (const auto& key : keys)
+		{
+			hint = hint_bst.Put(hint, key);
+		}
+		auto hint_end = std::chrono::steady_clock::now();
+		const TreeStats hint_stats = TakeThreadTreeStats();
+
+		std::cout << name << " size:" << hint_bst.Size() << " balanced:" << hint_bst.IsBalanced() << " size correct:" << hint_bst.IsSizeConsistent()
+			<< " put us:" << std::chrono::duration_cast<std::chrono::microseconds>(put_end - begin).count()
+			<< " hinted put us:" << std::chrono::duration_cast<std::chrono::microseconds>(hint_end - put_end).count() << std::endl;
+		if (kTreeStatsEnabled)
+		{
+			std::cout << name << " put compare:" << put_stats.put_compare << " hinted put compare:" << hint_stats.put_compare << std::endl;
+		}
+	};
+
+	run("append", append_keys);
+	run("band", band_keys);
+
+	// һҵλÿʼҸļ
+	RedBlackBST<std::string> bst;
+	bst.BuildFromSorted(append_keys.begin(), append_keys.end());
+	auto cursor = bst.begin();
+	int found_num = 0;
+	for (int i = 0; i < num; i += 3)
+	{
+		auto it = bst.Find(cursor, append_keys[i]);
+		if (it != bst.end())
+		{
+			++found_num;
+			cursor = it;
+		}
+	}
+	std::cout << "finger find:" << found_num << std::endl;
+}
+
+// 󲿷ֲѯȵʱԱȺչGetRank
+void TestSplayTree(int num, int hot_num)
+{
+	PrintFormat("TestSplayTree");
+
+	std::vector<int> keys(num);
+	std::iota(keys.begin(), keys.end(), 1);
+	std::shuffle(keys.begin(), keys.end(), std::default_random_engine(1));
+
+	// ųɲѯhot_numȵϡȵӲ˳ѡ
+	// ȡȲЩںбܽ
+	std::default_random_engine e1(2);
+	std::uniform_int_distribution<int> hot_dist(0, hot_num - 1);
+	std::uniform_int_distribution<int> cold_dist(0, num - 1);
+	std::uniform_int_distribution<int> percent_dist(0, 99);
+	std::vector<int> hot_keys;
+	for (int i = 0; i < hot_num; i++)
+	{
+		hot_keys.push_back(keys[cold_dist(e1)]);
+	}
+	std::vector<int> probes;
+	for (int i = 0; i < num; i++)
+	{
+		probes.push_back(percent_dist(e1) < 90 ? hot_keys[hot_dist(e1)] : keys[cold_dist(e1)]);
+	}
+
+	auto run = [&probes, &keys](const char* name, auto& tree)
+	{
+		for (int key : keys)
+		{
+			tree.Put(key);
+		}
+
+		auto begin = std::chrono::steady_clock::now();
+		long long sum = 0;
+		for (int key : probes)
+		{
+			sum += tree.Get(key)->val + tree.Rank(key);
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		std::cout << name << " size:" << tree.Size() << " height:" << tree.Height() << " sum:" << sum
+			<< " us:" << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << std::endl;
+	};
+
+	RedBlackBST<int> bst;
+	run("RedBlackBST", bst);
+
+	SplayTree<int> splay_tree;
+	run("SplayTree", splay_tree);
+}
+
+void TestCloneAndMove(int num, int thread_num)
+{
+	PrintFormat("TestCloneAndMove");
+
+	RedBlackBST<int> bst;
+	std::vector<int> vals(num);
+	std::iota(vals.begin(), vals.end(), 0);
+	bst.BuildFromSorted(vals.begin(), vals.end());
+
+	auto begin = std::chrono::steady_clock::now();
+	RedBlackBST<int> copy = bst.Clone();
+	auto serial_end = std::chrono::steady_clock::now();
+	RedBlackBST<int> parallel_copy = bst.Clone(thread_num);
+	auto parallel_end = std::chrono::steady_clock::now();
+	std::cout << "clone size:" << copy.Size() << " parallel size:" << parallel_copy.Size()
+		<< " is balanced:" << (copy.IsBST() && copy.IsBalanced() && parallel_copy.IsBST() && parallel_copy.IsBalanced())
+		<< " us:" << std::chrono::duration_cast<std::chrono::microseconds>(serial_end - begin).count()
+		<< " parallel us:" << std::chrono::duration_cast<std::chrono::microseconds>(parallel_end - serial_end).count() << std::endl;
+
+	// ԭӰ
+	copy.Delete(0);
+	std::cout << "after delete in copy, bst size:" << bst.Size() << " copy size:" << copy.Size() << std::endl;
+
+	// طʱ˻Ϊ̣߳ʹԼĽڵ
+	RedBlackBST<int, PoolNodeAllocator> pool_bst;
+	pool_bst.BuildFromSorted(vals.begin(), vals.end());
+	RedBlackBST<int, PoolNodeAllocator> pool_copy = pool_bst.Clone(thread_num);
+	std::cout << "pool clone size:" << pool_copy.Size() << " share pool:" << (pool_copy.GetAllocator() == pool_bst.GetAllocator()) << std::endl;
+
+	RedBlackBST<int> moved(std::move(copy));
+	RedBlackBST<int> other;
+	other.Put(-1);
+	moved.Swap(other);
+	copy = std::move(other);
+	std::cout << "moved size:" << moved.Size() << " other size:" << other.Size() << " copy size:" << copy.Size() << std::endl;
+}
+
+void TestMultiset(int num, int distinct_num)
+{
+	PrintFormat("TestMultiset");
+
+	// ظķֻͬռһڵ
+	RedBlackBST<int> bst;
+	bst.SetMultiset(true);
+	for (int i = 0; i < num; i++)
+	{
+		bst.Put(rand() % distinct_num);
+	}
+	int node_num = std::distance(bst.begin(), bst.end());
+	int mid = bst.Select(bst.Size() / 2)->val;
+	std::cout << "size:" << bst.Size() << " node num:" << node_num << " is balanced:" << (bst.IsBST() && bst.IsBalanced()) << std::endl;
+	std::cout << "median:" << mid << " count:" << bst.Count(mid) << " less:" << bst.CountLess(mid) << " less equal:" << bst.CountLessEqual(mid) << std::endl;
+
+	// ɾֻһ
+	bst.Delete(mid);
+	std::cout << "after delete, count:" << bst.Count(mid) << " size:" << bst.Size() << std::endl;
+
+	// رնؼģʽÿֵֻһ
+	bst.SetMultiset(false);
+	std::cout << "set mode size:" << bst.Size() << " count:" << bst.Count(mid) << std::endl;
 }
 
 int main()
@@ -342,6 +1312,84 @@ int main()
 		TestPutInt(bst, 100);
 		TestDescend(bst);
 	}
+	{
+		TestAllocatorBenchmark<HeapNodeAllocator>("HeapNodeAllocator", 100000);
+		TestAllocatorBenchmark<PoolNodeAllocator>("PoolNodeAllocator", 100000);
+	}
+	{
+		std::default_random_engine e1(1);
+		std::uniform_int_distribution<int> uniform_dist(1, 1000000);
+
+		std::vector<Player> players;
+		for (int i = 0; i < 100000; i++)
+		{
+			players.emplace_back(uniform_dist(e1));
+		}
+
+		RedBlackBST<Player> bst;
+		TestLayoutBenchmark("RedBlackBST", bst, players);
+
+		CompactRedBlackBST<Player> compact_bst;
+		TestLayoutBenchmark("CompactRedBlackBST", compact_bst, players);
+		std::cout << "bytes per entry:" << compact_bst.MemoryUsage() / compact_bst.Size() << std::endl;
+
+		BPlusTree<Player> bplus_tree;
+		TestLayoutBenchmark("BPlusTree", bplus_tree, players);
+		std::cout << "bytes per entry:" << bplus_tree.MemoryUsage() / bplus_tree.Size() << " height:" << bplus_tree.Height() << std::endl;
+	}
+	{
+		TestUpdateBenchmark(100000);
+	}
+	{
+		TestPutBatchBenchmark(100000, 1000);
+	}
+	{
+		RedBlackBST<int> bst;
+		TestPutInt(bst, 100);
+		TestTopAndRange(bst, 10, 100, 200);
+	}
+	{
+		TestTransparentLookup(100);
+	}
+	{
+		TestSnapshotRead(100);
+	}
+	{
+		TestShardedLeaderboard(100000, 4);
+	}
+	{
+		TestFreezeBenchmark(100000);
+	}
+	{
+		TestTreeFile(1000000, "red_black_bst.tree");
+	}
+	{
+		TestJournal(100000, "red_black_bst_journal.tree", "red_black_bst.journal");
+	}
+	{
+		TestTreeStats(10000);
+	}
+	{
+		TestHintedPut(300000, 300);
+	}
+	{
+		TestCloneAndMove(1000000, 4);
+	}
+	{
+		TestSplayTree(1000000, 100);
+	}
+	{
+		TestSplitAndJoin(100000);
+	}
+	{
+		TestSetOperations(100000);
+	}
+	{
+		TestAugmentedSum(100000, 1000);
+	}
+	{
+		TestMultiset(1000000, 1000);
+	}
 	/*{
 		RedBlackBST<Player> bst;
 		TestPutInt(bst, 100000);
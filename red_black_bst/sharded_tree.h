@@ -0,0 +1,315 @@
+#ifndef SHARDED_TREE_H_
+#define SHARDED_TREE_H_
+
+#include "tree.h"
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// TShardԪطֵɿöĺϣÿƬһͬƬдڶϲС
+// ȫRankǸƬǰԪظ֮ͣȫSelectڸƬ֮˳ͳ
+// ᰴƬסзƬǾȷġ
+// ͬƬпеȼ۵Ԫأȫʱȼ۵ԪذƬ
+template<typename T,
+	typename TShard = std::hash<std::remove_reference_t<std::decay_t<T>>>,
+	template<typename> class TAllocator = HeapNodeAllocator,
+	typename TCompare = std::less<std::remove_reference_t<std::decay_t<T>>>>
+class ShardedRedBlackBST
+{
+public:
+	using RealTType = std::remove_reference_t<std::decay_t<T>>;
+	using TreeType = RedBlackBST<RealTType, TAllocator, TCompare>;
+
+	explicit ShardedRedBlackBST(int shard_num, const TShard& shard = TShard(), const TCompare& compare = TCompare()) :shard_(shard)
+	{
+		shard_num = std::max(shard_num, 1);
+		for (int i = 0; i < shard_num; i++)
+		{
+			shards_.emplace_back(new Shard(compare));
+		}
+	}
+
+	ShardedRedBlackBST(const ShardedRedBlackBST&) = delete;
+	ShardedRedBlackBST& operator=(const ShardedRedBlackBST&) = delete;
+
+public:
+	template<typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	void Put(NodeValType&& val)
+	{
+		Shard& shard = *shards_[ShardIndex(val)];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.tree.Put(std::forward<NodeValType>(val));
+	}
+
+	// ȰƬ飬ÿƬֻһ
+	template<typename TIterator>
+	void PutBatch(TIterator first, TIterator last)
+	{
+		std::vector<std::vector<RealTType>> groups(shards_.size());
+		for (; first != last; ++first)
+		{
+			groups[ShardIndex(*first)].push_back(*first);
+		}
+
+		for (size_t i = 0; i < groups.size(); i++)
+		{
+			if (groups[i].empty())
+			{
+				continue;
+			}
+
+			std::lock_guard<std::mutex> lock(shards_[i]->mutex);
+			shards_[i]->tree.PutBatch(std::make_move_iterator(groups[i].begin()), std::make_move_iterator(groups[i].end()));
+		}
+	}
+
+	void Delete(const RealTType& val)
+	{
+		Shard& shard = *shards_[ShardIndex(val)];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.tree.Delete(val);
+	}
+
+	// ¾ֵͬһƬʱֱUpdateKeyͬʱסƬӾɷƬɾŽ·Ƭ
+	// old_valڻ·Ƭnew_valʱ޸Ĳfalse
+	template<typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	const bool UpdateKey(const RealTType& old_val, NodeValType&& new_val)
+	{
+		const int old_index = ShardIndex(old_val);
+		const int new_index = ShardIndex(new_val);
+		if (old_index == new_index)
+		{
+			Shard& shard = *shards_[old_index];
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			return shard.tree.UpdateKey(old_val, std::forward<NodeValType>(new_val));
+		}
+
+		Shard& old_shard = *shards_[old_index];
+		Shard& new_shard = *shards_[new_index];
+		std::unique_lock<std::mutex> first_lock(old_index < new_index ? old_shard.mutex : new_shard.mutex);
+		std::unique_lock<std::mutex> second_lock(old_index < new_index ? new_shard.mutex : old_shard.mutex);
+
+		if (!old_shard.tree.IsExists(old_val) || new_shard.tree.IsExists(new_val))
+		{
+			return false;
+		}
+
+		old_shard.tree.Delete(old_val);
+		new_shard.tree.Put(std::forward<NodeValType>(new_val));
+
+		return true;
+	}
+
+	const bool IsExists(const RealTType& val)const
+	{
+		const Shard& shard = *shards_[ShardIndex(val)];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		return shard.tree.IsExists(val);
+	}
+
+	// ȫ1ʼvalʱ0
+	const int Rank(const RealTType& val)const
+	{
+		auto locks = LockAll();
+
+		const int index = ShardIndex(val);
+		int rank = shards_[index]->tree.Rank(val);
+		if (rank == 0)
+		{
+			return 0;
+		}
+
+		for (int i = 0; i < ShardNum(); i++)
+		{
+			if (i < index)
+			{
+				rank += shards_[i]->tree.CountLessEqual(val);
+			}
+			else if (i > index)
+			{
+				rank += shards_[i]->tree.CountLess(val);
+			}
+		}
+
+		return rank;
+	}
+
+	// ȡȫΪrankingԪأ1ʼԽʱfalse
+	// ÿںѡķƬȡλΪᣬȫλúзƬĺѡ䣬
+	// ڷƬĺѡÿټ룬O(S * logN)֣ÿO(S * logN)
+	const bool Select(int ranking, RealTType& val)const
+	{
+		auto locks = LockAll();
+
+		const int shard_num = ShardNum();
+		std::vector<int> low(shard_num, 0);
+		std::vector<int> high(shard_num, 0);
+		std::vector<int> pos(shard_num, 0);
+
+		int total = 0;
+		for (int i = 0; i < shard_num; i++)
+		{
+			high[i] = shards_[i]->tree.Size();
+			total += high[i];
+		}
+		if (ranking < 1 || ranking > total)
+		{
+			return false;
+		}
+
+		while (true)
+		{
+			int pivot = 0;
+			for (int i = 1; i < shard_num; i++)
+			{
+				if (high[i] - low[i] > high[pivot] - low[pivot])
+				{
+					pivot = i;
+				}
+			}
+
+			const int mid = (low[pivot] + high[pivot]) / 2;
+			const RealTType& pivot_val = shards_[pivot]->tree.Select(mid + 1)->val;
+
+			// pos[i]ǷƬiǰԪظ
+			int before = 0;
+			for (int i = 0; i < shard_num; i++)
+			{
+				if (i < pivot)
+				{
+					pos[i] = shards_[i]->tree.CountLessEqual(pivot_val);
+				}
+				else if (i > pivot)
+				{
+					pos[i] = shards_[i]->tree.CountLess(pivot_val);
+				}
+				else
+				{
+					pos[i] = mid;
+				}
+				before += pos[i];
+			}
+
+			if (before == ranking - 1)
+			{
+				val = pivot_val;
+				return true;
+			}
+
+			if (before < ranking - 1)
+			{
+				for (int i = 0; i < shard_num; i++)
+				{
+					low[i] = std::max(low[i], pos[i]);
+				}
+				low[pivot] = mid + 1;
+			}
+			else
+			{
+				for (int i = 0; i < shard_num; i++)
+				{
+					high[i] = std::min(high[i], pos[i]);
+				}
+				high[pivot] = mid;
+			}
+		}
+	}
+
+	const int Size()const
+	{
+		auto locks = LockAll();
+
+		int num = 0;
+		for (const auto& shard : shards_)
+		{
+			num += shard->tree.Size();
+		}
+
+		return num;
+	}
+
+	const bool IsEmpty()const
+	{
+		return Size() == 0;
+	}
+
+	void Clear()
+	{
+		auto locks = LockAll();
+		for (auto& shard : shards_)
+		{
+			shard->tree.Clear();
+		}
+	}
+
+	const int ShardNum()const noexcept
+	{
+		return static_cast<int>(shards_.size());
+	}
+
+	const int ShardIndex(const RealTType& val)const
+	{
+		return static_cast<int>(shard_(val) % shards_.size());
+	}
+
+	// ڷƬڷĳƬڹ߳ԼķƬ
+	template<typename TFun>
+	void VisitShard(int index, TFun&& fun)
+	{
+		std::lock_guard<std::mutex> lock(shards_[index]->mutex);
+		fun(shards_[index]->tree);
+	}
+
+private:
+	// ƬżƬUpdateKey
+	std::vector<std::unique_lock<std::mutex>> LockAll()const
+	{
+		std::vector<std::unique_lock<std::mutex>> locks;
+		locks.reserve(shards_.size());
+		for (const auto& shard : shards_)
+		{
+			locks.emplace_back(shard->mutex);
+		}
+
+		return locks;
+	}
+
+private:
+	static const int kCacheLineSize = 64;
+
+	// ÿƬ䣬ĩβһУڷƬ͸ڵ㲻ͬһ
+	struct Shard
+	{
+		explicit Shard(const TCompare& compare) :tree(compare)
+		{
+		}
+
+		mutable std::mutex mutex;
+		TreeType tree;
+		char padding[kCacheLineSize];
+	};
+
+	TShard shard_;
+	std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+#endif // !SHARDED_TREE_H_
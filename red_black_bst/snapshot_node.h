@@ -0,0 +1,38 @@
+#ifndef SNAPSHOT_NODE_H_
+#define SNAPSHOT_NODE_H_
+
+#include <cstdint>
+#include <utility>
+
+// Ľڵ㣬֮޸ģ汾δĶӽڵָ
+template<typename T>
+struct SnapshotNode
+{
+	SnapshotNode() = delete;
+	SnapshotNode& operator=(const SnapshotNode&) = delete;
+
+	// ·ʱڵ㣬ӽڵָԭڵ㹲
+	SnapshotNode(const SnapshotNode&) = default;
+
+	const static bool RED = true;
+	const static bool BLACK = false;
+
+	template<typename NodeValType>
+	SnapshotNode(NodeValType&& param, uint64_t ver) :left(nullptr), right(nullptr), val(std::forward<NodeValType>(param)), sub_node_num(1), color(RED), version(ver)
+	{
+	}
+
+	SnapshotNode* left;
+	SnapshotNode* right;
+
+	T val;
+
+	// ԸýڵΪеĽڵ
+	int sub_node_num;
+	// ڵɫ
+	bool color;
+	// ýڵд汾ţ뵱ǰ汾ͬ˵δԭ޸
+	uint64_t version;
+};
+
+#endif // !SNAPSHOT_NODE_H_
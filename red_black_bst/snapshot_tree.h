@@ -0,0 +1,808 @@
+#ifndef SNAPSHOT_TREE_H_
+#define SNAPSHOT_TREE_H_
+
+#include "snapshot_node.h"
+#include "epoch_manager.h"
+
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <stack>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// ֧ն
+// д·°汾ͨԭָ뷢µĸڵ㣬滻Ľڵ㰴epochӳͷţ
+// ͨGetSnapshot()õĳ汾ĸڵ㣬ڼ䲻ʼһµһ
+// д֮ûлʱдĿ
+template<typename T>
+class SnapshotRedBlackBST
+{
+public:
+	using RealTType = std::remove_reference_t<std::decay_t<T>>;
+	using NodeType = SnapshotNode<RealTType>;
+
+	// ĳ汾ֻͼڼð汾нڵ㶼ᱻͷ
+	class Snapshot
+	{
+	public:
+		Snapshot(EpochManager* epoch_manager, const std::atomic<NodeType*>& root) :epoch_manager_(epoch_manager)
+		{
+			slot_ = epoch_manager_->Enter();
+			root_ = root.load(std::memory_order_seq_cst);
+		}
+
+		~Snapshot()
+		{
+			if (epoch_manager_ != nullptr)
+			{
+				epoch_manager_->Exit(slot_);
+			}
+		}
+
+		Snapshot(const Snapshot&) = delete;
+		Snapshot& operator=(const Snapshot&) = delete;
+
+		Snapshot(Snapshot&& other)noexcept :epoch_manager_(other.epoch_manager_), slot_(other.slot_), root_(other.root_)
+		{
+			other.epoch_manager_ = nullptr;
+		}
+
+		Snapshot& operator=(Snapshot&&) = delete;
+
+		template<typename NodeValType>
+		NodeType const*const Get(NodeValType&& val)const noexcept
+		{
+			const NodeType* node = root_;
+			while (node != nullptr)
+			{
+				if (val < node->val)
+				{
+					node = node->left;
+				}
+				else if (node->val < val)
+				{
+					node = node->right;
+				}
+				else
+				{
+					return val == node->val ? node : nullptr;
+				}
+			}
+
+			return nullptr;
+		}
+
+		template<typename NodeValType>
+		const bool IsExists(NodeValType&& val)const noexcept
+		{
+			return Get(std::forward<NodeValType>(val)) != nullptr;
+		}
+
+		NodeType const*const Min()const noexcept
+		{
+			const NodeType* node = root_;
+			while (node != nullptr && node->left != nullptr)
+			{
+				node = node->left;
+			}
+
+			return node;
+		}
+
+		NodeType const*const Max()const noexcept
+		{
+			const NodeType* node = root_;
+			while (node != nullptr && node->right != nullptr)
+			{
+				node = node->right;
+			}
+
+			return node;
+		}
+
+		NodeType const*const Select(int ranking)const noexcept
+		{
+			const NodeType* node = root_;
+			while (node != nullptr)
+			{
+				int num = SnapshotRedBlackBST::Size(node->left) + 1;
+				if (num > ranking)
+				{
+					node = node->left;
+				}
+				else if (num < ranking)
+				{
+					ranking -= num;
+					node = node->right;
+				}
+				else
+				{
+					return node;
+				}
+			}
+
+			return nullptr;
+		}
+
+		template<typename NodeValType>
+		const int Rank(NodeValType&& val)const noexcept
+		{
+			int rank = 0;
+			const NodeType* node = root_;
+			while (node != nullptr)
+			{
+				if (val < node->val)
+				{
+					node = node->left;
+				}
+				else if (node->val < val)
+				{
+					rank += SnapshotRedBlackBST::Size(node->left) + 1;
+					node = node->right;
+				}
+				else
+				{
+					return rank + SnapshotRedBlackBST::Size(node->left) + 1;
+				}
+			}
+
+			return 0;
+		}
+
+		template<typename NodeValType>
+		NodeType const*const Floor(NodeValType&& val)const noexcept
+		{
+			const NodeType* floor = nullptr;
+			const NodeType* node = root_;
+			while (node != nullptr)
+			{
+				if (val <= node->val)
+				{
+					node = node->left;
+				}
+				else
+				{
+					floor = node;
+					node = node->right;
+				}
+			}
+
+			return floor;
+		}
+
+		template<typename NodeValType>
+		NodeType const*const Ceiling(NodeValType&& val)const noexcept
+		{
+			const NodeType* ceiling = nullptr;
+			const NodeType* node = root_;
+			while (node != nullptr)
+			{
+				if (node->val <= val)
+				{
+					node = node->right;
+				}
+				else
+				{
+					ceiling = node;
+					node = node->left;
+				}
+			}
+
+			return ceiling;
+		}
+
+		template<typename TTraversingCb>
+		void MiddleOrderWithRecursion(TTraversingCb&& fun)const noexcept
+		{
+			MiddleOrderWithRecursion(root_, std::forward<TTraversingCb>(fun));
+		}
+
+		template<typename TTraversingCb>
+		void DescendTraverse(TTraversingCb&& fun)const noexcept
+		{
+			DescendTraverse(root_, std::forward<TTraversingCb>(fun));
+		}
+
+		const bool IsEmpty()const noexcept
+		{
+			return root_ == nullptr;
+		}
+
+		const int Size()const noexcept
+		{
+			return SnapshotRedBlackBST::Size(root_);
+		}
+
+		NodeType const*const GetRoot()const noexcept
+		{
+			return root_;
+		}
+
+	private:
+		template<typename TTraversingCb>
+		void MiddleOrderWithRecursion(const NodeType* node, TTraversingCb&& fun)const noexcept
+		{
+			if (nullptr == node)
+			{
+				return;
+			}
+			MiddleOrderWithRecursion(node->left, std::forward<TTraversingCb>(fun));
+			fun(node->val);
+			MiddleOrderWithRecursion(node->right, std::forward<TTraversingCb>(fun));
+		}
+
+		template<typename TTraversingCb>
+		void DescendTraverse(const NodeType* node, TTraversingCb&& fun)const noexcept
+		{
+			if (nullptr == node)
+			{
+				return;
+			}
+			DescendTraverse(node->right, std::forward<TTraversingCb>(fun));
+			fun(node->val);
+			DescendTraverse(node->left, std::forward<TTraversingCb>(fun));
+		}
+
+	private:
+		EpochManager* epoch_manager_;
+		int slot_;
+		const NodeType* root_;
+	};
+
+	SnapshotRedBlackBST() :root_(nullptr), version_(0)
+	{
+	}
+
+	~SnapshotRedBlackBST()
+	{
+		FreeTree(root_.load(std::memory_order_relaxed));
+		for (auto& batch : retired_)
+		{
+			for (auto node : batch.nodes)
+			{
+				delete node;
+			}
+		}
+	}
+
+	SnapshotRedBlackBST(const SnapshotRedBlackBST&) = delete;
+	SnapshotRedBlackBST& operator=(const SnapshotRedBlackBST&) = delete;
+
+	SnapshotRedBlackBST(SnapshotRedBlackBST&&) = delete;
+	SnapshotRedBlackBST& operator=(SnapshotRedBlackBST&&) = delete;
+
+public:
+	// ӿڶڿϣҪͷţ֮ݵĽڵ㶼޷
+	Snapshot GetSnapshot()const noexcept
+	{
+		return Snapshot(&epoch_manager_, root_);
+	}
+
+	// ֵֻĲѯȡһο
+	template<typename NodeValType>
+	const bool IsExists(NodeValType&& val)const noexcept
+	{
+		return GetSnapshot().IsExists(std::forward<NodeValType>(val));
+	}
+
+	template<typename NodeValType>
+	const int Rank(NodeValType&& val)const noexcept
+	{
+		return GetSnapshot().Rank(std::forward<NodeValType>(val));
+	}
+
+	const int Size()const noexcept
+	{
+		return GetSnapshot().Size();
+	}
+
+	const bool IsEmpty()const noexcept
+	{
+		return root_.load(std::memory_order_acquire) == nullptr;
+	}
+
+	template<typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	void Put(NodeValType&& val)
+	{
+		std::lock_guard<std::mutex> lock(write_mutex_);
+
+		NodeType* root = root_.load(std::memory_order_relaxed);
+		if (Find(root, val) != nullptr)
+		{
+			return;
+		}
+
+		BeginWrite();
+		root = Put(root, std::forward<NodeValType>(val));
+		root->color = NodeType::BLACK;
+		Publish(root);
+	}
+
+	template<typename NodeValType>
+	void Delete(NodeValType&& val)
+	{
+		std::lock_guard<std::mutex> lock(write_mutex_);
+
+		NodeType* root = root_.load(std::memory_order_relaxed);
+		const NodeType* node = Find(root, val);
+		if (node == nullptr || !(val == node->val))
+		{
+			return;
+		}
+
+		BeginWrite();
+		Publish(DeleteFromRoot(root, val));
+	}
+
+	// ɾֵͲֵΪһ汾߲ῴֵʧм״̬
+	template<typename OldValType, typename NodeValType>
+	const bool UpdateKey(const OldValType& old_val, NodeValType&& new_val)
+	{
+		std::lock_guard<std::mutex> lock(write_mutex_);
+
+		NodeType* root = root_.load(std::memory_order_relaxed);
+		const NodeType* node = Find(root, old_val);
+		if (node == nullptr || !(old_val == node->val))
+		{
+			return false;
+		}
+
+		// ֵԪصȼʱ޸
+		const NodeType* exist = Find(root, new_val);
+		if (exist != nullptr && exist != node)
+		{
+			return false;
+		}
+
+		BeginWrite();
+		root = DeleteFromRoot(root, old_val);
+		root = Put(root, std::forward<NodeValType>(new_val));
+		root->color = NodeType::BLACK;
+		Publish(root);
+
+		return true;
+	}
+
+	void DelMin()
+	{
+		std::lock_guard<std::mutex> lock(write_mutex_);
+
+		NodeType* root = root_.load(std::memory_order_relaxed);
+		if (root == nullptr)
+		{
+			return;
+		}
+
+		BeginWrite();
+		root = PrepareRootForDelete(root);
+		root = DelMin(root);
+		Publish(FinishRootAfterDelete(root));
+	}
+
+	void DelMax()
+	{
+		std::lock_guard<std::mutex> lock(write_mutex_);
+
+		NodeType* root = root_.load(std::memory_order_relaxed);
+		if (root == nullptr)
+		{
+			return;
+		}
+
+		BeginWrite();
+		root = PrepareRootForDelete(root);
+		root = DelMax(root);
+		Publish(FinishRootAfterDelete(root));
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(write_mutex_);
+
+		BeginWrite();
+		RetireTree(root_.load(std::memory_order_relaxed));
+		Publish(nullptr);
+	}
+
+	// ȴյĽڵʱ䲻½˵пûͷ
+	const size_t PendingReclaimNum()const noexcept
+	{
+		std::lock_guard<std::mutex> lock(write_mutex_);
+
+		size_t num = 0;
+		for (const auto& batch : retired_)
+		{
+			num += batch.nodes.size();
+		}
+
+		return num;
+	}
+
+private:
+	struct RetiredBatch
+	{
+		uint64_t epoch;
+		std::vector<NodeType*> nodes;
+	};
+
+	static const int Size(const NodeType* node)noexcept
+	{
+		if (node == nullptr)
+		{
+			return 0;
+		}
+
+		return node->sub_node_num;
+	}
+
+	static const bool IsRed(const NodeType* node)noexcept
+	{
+		if (node == nullptr)
+		{
+			return false;
+		}
+
+		return node->color == NodeType::RED;
+	}
+
+	// ȼ۹ϵңдʼǰжǷҪ°汾
+	template<typename NodeValType>
+	const NodeType* Find(const NodeType* node, const NodeValType& val)const noexcept
+	{
+		while (node != nullptr)
+		{
+			if (val < node->val)
+			{
+				node = node->left;
+			}
+			else if (node->val < val)
+			{
+				node = node->right;
+			}
+			else
+			{
+				return node;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void BeginWrite()noexcept
+	{
+		++version_;
+	}
+
+	// µĸڵ㣬ƽepochȻѾûжߵľɽڵ
+	void Publish(NodeType* root)
+	{
+		root_.store(root, std::memory_order_seq_cst);
+
+		uint64_t epoch = epoch_manager_.Advance();
+		if (!pending_.empty())
+		{
+			retired_.push_back(RetiredBatch{ epoch, std::move(pending_) });
+			pending_.clear();
+		}
+
+		uint64_t min_epoch = epoch_manager_.MinActiveEpoch();
+		while (!retired_.empty() && retired_.front().epoch < min_epoch)
+		{
+			for (auto node : retired_.front().nodes)
+			{
+				delete node;
+			}
+			retired_.pop_front();
+		}
+	}
+
+	template<typename NodeValType>
+	NodeType* NewNode(NodeValType&& val)
+	{
+		return new NodeType(std::forward<NodeValType>(val), version_);
+	}
+
+	// ȡÿԭ޸ĵĽڵ㣺д½ĽڵֱӷأѷĽڵ㸴һݣԭڵ
+	NodeType* Own(NodeType* node)
+	{
+		if (node == nullptr || node->version == version_)
+		{
+			return node;
+		}
+
+		NodeType* copy = new NodeType(*node);
+		copy->version = version_;
+		Retire(node);
+
+		return copy;
+	}
+
+	// δĽڵûжߣͷ
+	void Retire(NodeType* node)
+	{
+		if (node->version == version_)
+		{
+			delete node;
+			return;
+		}
+
+		pending_.push_back(node);
+	}
+
+	void RetireTree(NodeType* node)
+	{
+		if (node == nullptr)
+		{
+			return;
+		}
+
+		RetireTree(node->left);
+		RetireTree(node->right);
+		Retire(node);
+	}
+
+	void FreeTree(NodeType* node)noexcept
+	{
+		if (node == nullptr)
+		{
+			return;
+		}
+
+		FreeTree(node->left);
+		FreeTree(node->right);
+		delete node;
+	}
+
+	template<typename NodeValType>
+	NodeType* Put(NodeType* node, NodeValType&& param)
+	{
+		if (node == nullptr)
+		{
+			return NewNode(std::forward<NodeValType>(param));
+		}
+
+		node = Own(node);
+		if (param < node->val)
+		{
+			node->left = Put(node->left, std::forward<NodeValType>(param));
+		}
+		else
+		{
+			node->right = Put(node->right, std::forward<NodeValType>(param));
+		}
+
+		return Balance(node);
+	}
+
+	NodeType* PrepareRootForDelete(NodeType* root)
+	{
+		if (!IsRed(root->left) && !IsRed(root->right))
+		{
+			root = Own(root);
+			root->color = NodeType::RED;
+		}
+
+		return root;
+	}
+
+	NodeType* FinishRootAfterDelete(NodeType* root)
+	{
+		if (root != nullptr && IsRed(root))
+		{
+			root = Own(root);
+			root->color = NodeType::BLACK;
+		}
+
+		return root;
+	}
+
+	template<typename NodeValType>
+	NodeType* DeleteFromRoot(NodeType* root, const NodeValType& val)
+	{
+		root = PrepareRootForDelete(root);
+		root = Delete(root, val);
+
+		return FinishRootAfterDelete(root);
+	}
+
+	template<typename NodeValType>
+	NodeType* Delete(NodeType* node, const NodeValType& val)
+	{
+		if (node == nullptr)
+		{
+			return nullptr;
+		}
+
+		node = Own(node);
+		if (val < node->val)
+		{
+			if (node->left != nullptr && !IsRed(node->left) && !IsRed(node->left->left))
+			{
+				node = MoveRedLeft(node);
+			}
+			node->left = Delete(node->left, val);
+		}
+		else
+		{
+			if (IsRed(node->left))
+			{
+				node = RotateRight(node);
+			}
+			if (!(node->val < val) && node->right == nullptr)
+			{
+				Retire(node);
+				return nullptr;
+			}
+			if (node->right != nullptr && !IsRed(node->right) && !IsRed(node->right->left))
+			{
+				node = MoveRedRight(node);
+			}
+			if (!(node->val < val))
+			{
+				const NodeType* min_node = node->right;
+				while (min_node->left != nullptr)
+				{
+					min_node = min_node->left;
+				}
+				node->val = min_node->val;
+				node->right = DelMin(node->right);
+			}
+			else
+			{
+				node->right = Delete(node->right, val);
+			}
+		}
+
+		return Balance(node);
+	}
+
+	NodeType* DelMin(NodeType* node)
+	{
+		if (node->left == nullptr)
+		{
+			Retire(node);
+			return nullptr;
+		}
+
+		node = Own(node);
+		if (!IsRed(node->left) && !IsRed(node->left->left))
+		{
+			node = MoveRedLeft(node);
+		}
+
+		node->left = DelMin(node->left);
+
+		return Balance(node);
+	}
+
+	NodeType* DelMax(NodeType* node)
+	{
+		node = Own(node);
+		if (IsRed(node->left))
+		{
+			node = RotateRight(node);
+		}
+
+		if (node->right == nullptr)
+		{
+			Retire(node);
+			return nullptr;
+		}
+
+		if (!IsRed(node->right) && !IsRed(node->right->left))
+		{
+			node = MoveRedRight(node);
+		}
+
+		node->right = DelMax(node->right);
+
+		return Balance(node);
+	}
+
+	// ޸ĲĲڵ㶼ѾOwn漰ӽڵ޸ǰOwn
+	NodeType* RotateRight(NodeType* node)
+	{
+		NodeType* tmp = Own(node->left);
+		node->left = tmp->right;
+		tmp->sub_node_num = node->sub_node_num;
+		node->sub_node_num = Size(node->left) + Size(node->right) + 1;
+		tmp->right = node;
+		tmp->color = node->color;
+		node->color = NodeType::RED;
+
+		return tmp;
+	}
+
+	NodeType* RotateLeft(NodeType* node)
+	{
+		NodeType* tmp = Own(node->right);
+		node->right = tmp->left;
+		tmp->sub_node_num = node->sub_node_num;
+		node->sub_node_num = Size(node->left) + Size(node->right) + 1;
+		tmp->left = node;
+		tmp->color = node->color;
+		node->color = NodeType::RED;
+
+		return tmp;
+	}
+
+	void FlipColor(NodeType* node)
+	{
+		node->left = Own(node->left);
+		node->right = Own(node->right);
+
+		node->color = !node->color;
+		node->left->color = !node->left->color;
+		node->right->color = !node->right->color;
+	}
+
+	NodeType* Balance(NodeType* node)
+	{
+		if (IsRed(node->right) && !IsRed(node->left))
+		{
+			node = RotateLeft(node);
+		}
+
+		if (IsRed(node->left) && IsRed(node->left->left))
+		{
+			node = RotateRight(node);
+		}
+
+		if (IsRed(node->left) && IsRed(node->right))
+		{
+			FlipColor(node);
+		}
+
+		node->sub_node_num = Size(node->left) + Size(node->right) + 1;
+
+		return node;
+	}
+
+	NodeType* MoveRedLeft(NodeType* node)
+	{
+		FlipColor(node);
+		if (IsRed(node->right->left))
+		{
+			node->right = RotateRight(node->right);
+			node = RotateLeft(node);
+			FlipColor(node);
+		}
+
+		return node;
+	}
+
+	NodeType* MoveRedRight(NodeType* node)
+	{
+		FlipColor(node);
+		if (IsRed(node->left->left))
+		{
+			node = RotateRight(node);
+			FlipColor(node);
+		}
+
+		return node;
+	}
+
+private:
+	std::atomic<NodeType*> root_;
+
+	// д߶ռ״̬
+	mutable std::mutex write_mutex_;
+	uint64_t version_;
+	std::vector<NodeType*> pending_;
+	std::deque<RetiredBatch> retired_;
+
+	mutable EpochManager epoch_manager_;
+};
+
+#endif // !SNAPSHOT_TREE_H_
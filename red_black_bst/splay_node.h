@@ -0,0 +1,36 @@
+#ifndef SPLAY_NODE_H_
+#define SPLAY_NODE_H_
+
+#include "node_allocator.h"
+
+#include <memory>
+#include <type_traits>
+
+// չĽڵ㣬ûɫNodeͬ
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator>
+struct SplayNode
+{
+	using UniqueNodeType = std::unique_ptr<SplayNode, typename TAllocator<SplayNode>::Deleter>;
+
+	SplayNode() = delete;
+	SplayNode(const SplayNode&) = delete;
+	SplayNode& operator=(const SplayNode&) = delete;
+
+	// ֵҪʱڵؿ鶪ڵ
+	const static bool TRIVIALLY_DISCARDABLE = std::is_trivially_destructible<T>::value;
+
+	template<typename NodeValType>
+	explicit SplayNode(NodeValType&& param) :left(nullptr), right(nullptr), val(std::forward<NodeValType>(param)), sub_node_num(1)
+	{
+	}
+
+	UniqueNodeType left;
+	UniqueNodeType right;
+
+	T val;
+
+	// ԸýڵΪеĽڵ
+	int sub_node_num;
+};
+
+#endif // !SPLAY_NODE_H_
@@ -0,0 +1,1014 @@
+#ifndef SPLAY_TREE_H_
+#define SPLAY_TREE_H_
+
+#include "splay_node.h"
+#include "tree_iterator.h"
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// չ˫TreeIteratorֻͬĸ߶ûޣ·vector
+template<typename TNode>
+class SplayTreeIterator
+{
+public:
+	using ValueType = std::remove_reference_t<decltype(std::declval<TNode&>().val)>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = ValueType;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const ValueType*;
+	using reference = const ValueType&;
+
+	SplayTreeIterator() :root_(nullptr)
+	{
+	}
+
+	explicit SplayTreeIterator(const TNode* root) :root_(root)
+	{
+	}
+
+	reference operator*()const noexcept
+	{
+		return path_.back()->val;
+	}
+
+	pointer operator->()const noexcept
+	{
+		return &path_.back()->val;
+	}
+
+	SplayTreeIterator& operator++()
+	{
+		const TNode* node = path_.back();
+		if (node->right != nullptr)
+		{
+			Push(node->right.get());
+			PushLeftSpine();
+			return *this;
+		}
+
+		// ݵһ
+		const TNode* child = path_.back();
+		path_.pop_back();
+		while (!path_.empty() && path_.back()->right.get() == child)
+		{
+			child = path_.back();
+			path_.pop_back();
+		}
+
+		return *this;
+	}
+
+	SplayTreeIterator operator++(int)
+	{
+		SplayTreeIterator tmp = *this;
+		++(*this);
+		return tmp;
+	}
+
+	SplayTreeIterator& operator--()
+	{
+		if (path_.empty())
+		{
+			if (root_ != nullptr)
+			{
+				Push(root_);
+				PushRightSpine();
+			}
+			return *this;
+		}
+
+		const TNode* node = path_.back();
+		if (node->left != nullptr)
+		{
+			Push(node->left.get());
+			PushRightSpine();
+			return *this;
+		}
+
+		const TNode* child = path_.back();
+		path_.pop_back();
+		while (!path_.empty() && path_.back()->left.get() == child)
+		{
+			child = path_.back();
+			path_.pop_back();
+		}
+
+		return *this;
+	}
+
+	SplayTreeIterator operator--(int)
+	{
+		SplayTreeIterator tmp = *this;
+		--(*this);
+		return tmp;
+	}
+
+	bool operator==(const SplayTreeIterator& other)const noexcept
+	{
+		return Current() == other.Current();
+	}
+
+	bool operator!=(const SplayTreeIterator& other)const noexcept
+	{
+		return Current() != other.Current();
+	}
+
+	// ǰڵ㣬end()ʱΪnullptr
+	const TNode* Current()const noexcept
+	{
+		return path_.empty() ? nullptr : path_.back();
+	}
+
+	const int Depth()const noexcept
+	{
+		return static_cast<int>(path_.size());
+	}
+
+	void Push(const TNode* node)
+	{
+		path_.push_back(node);
+	}
+
+	void Truncate(int depth)
+	{
+		path_.resize(depth);
+	}
+
+	void PushLeftSpine()
+	{
+		const TNode* node = path_.back();
+		while (node->left != nullptr)
+		{
+			node = node->left.get();
+			path_.push_back(node);
+		}
+	}
+
+	void PushRightSpine()
+	{
+		const TNode* node = path_.back();
+		while (node->right != nullptr)
+		{
+			node = node->right.get();
+			path_.push_back(node);
+		}
+	}
+
+private:
+	const TNode* root_;
+	std::vector<const TNode*> path_;
+};
+
+// չӿRedBlackBSTһ£TCompare÷Ҳͬ
+// PutDeleteMinMaxѷʵĽڵչGetRankSelectFloorCeilingCountLessֻչת룬
+// ƵʵȵܽʷֲԽԽ죻
+// еľ̯ӶO(logN)βO(N)
+// ЩѯĽṹԲconstԱ߳ͬʱѯҲҪ
+// LowerBoundUpperBoundRangeͱṹconstʹá
+// ܺвݹ
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator,
+	typename TCompare = std::less<std::remove_reference_t<std::decay_t<T>>>>
+class SplayTree
+{
+public:
+	using RealTType = std::remove_reference_t<std::decay_t<T>>;
+	using NodeType = SplayNode<RealTType, TAllocator>;
+	using UniqueNodeType = typename NodeType::UniqueNodeType;
+	using AllocatorType = TAllocator<NodeType>;
+	using CompareType = TCompare;
+	using ConstIterator = SplayTreeIterator<NodeType>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+	using RangeType = IteratorRange<ConstIterator>;
+
+	using value_type = RealTType;
+	using const_iterator = ConstIterator;
+	using iterator = ConstIterator;
+	using const_reverse_iterator = ConstReverseIterator;
+	using reverse_iterator = ConstReverseIterator;
+
+	SplayTree() :root_(nullptr)
+	{
+	}
+
+	explicit SplayTree(const AllocatorType& alloc) :alloc_(alloc), root_(nullptr)
+	{
+	}
+
+	explicit SplayTree(const CompareType& compare, const AllocatorType& alloc = AllocatorType()) :compare_(compare), alloc_(alloc), root_(nullptr)
+	{
+	}
+
+	~SplayTree()
+	{
+		Clear();
+	}
+
+	SplayTree(const SplayTree&) = delete;
+	SplayTree& operator=(const SplayTree&) = delete;
+
+	SplayTree(SplayTree&&) = delete;
+	SplayTree& operator=(SplayTree&&) = delete;
+
+public:
+	template<typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	void Put(NodeValType&& val)
+	{
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (compare_(val, node->val))
+			{
+				slot = &node->left;
+			}
+			else if (compare_(node->val, val))
+			{
+				slot = &node->right;
+			}
+			else
+			{
+				Splay();
+				return;
+			}
+		}
+
+		// תʱӽڵ¼Ȱ·ϵļӺ
+		for (UniqueNodeType* parent : path_)
+		{
+			++(*parent)->sub_node_num;
+		}
+		*slot = alloc_.New(std::forward<NodeValType>(val));
+		path_.push_back(slot);
+		Splay();
+	}
+
+	template<typename NodeValType>
+	NodeType const*const Get(NodeValType&& val)
+	{
+		NodeType* found = nullptr;
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (compare_(val, node->val))
+			{
+				slot = &node->left;
+			}
+			else if (compare_(node->val, val))
+			{
+				slot = &node->right;
+			}
+			else
+			{
+				found = IsEqual(val, node->val) ? node : nullptr;
+				break;
+			}
+		}
+		SemiSplay();
+
+		return found;
+	}
+
+	const int Height()const
+	{
+		int height = 0;
+		std::vector<std::pair<NodeType*, int>> stack;
+		if (root_ != nullptr)
+		{
+			stack.emplace_back(root_.get(), 1);
+		}
+		while (!stack.empty())
+		{
+			auto top = stack.back();
+			stack.pop_back();
+			height = std::max(height, top.second);
+			if (top.first->left != nullptr)
+			{
+				stack.emplace_back(top.first->left.get(), top.second + 1);
+			}
+			if (top.first->right != nullptr)
+			{
+				stack.emplace_back(top.first->right.get(), top.second + 1);
+			}
+		}
+
+		return height;
+	}
+
+	template<typename NodeValType>
+	const bool IsExists(NodeValType&& val)
+	{
+		return Get(std::forward<NodeValType>(val)) != nullptr;
+	}
+
+	const bool IsBST()const
+	{
+		const RealTType* prev = nullptr;
+		bool ordered = true;
+		MiddleOrderWithRecursion([this, &prev, &ordered](const RealTType& val)
+		{
+			if (prev != nullptr && !compare_(*prev, val))
+			{
+				ordered = false;
+			}
+			prev = &val;
+		});
+
+		return ordered;
+	}
+
+	const bool IsSizeConsistent()const
+	{
+		std::vector<NodeType*> stack;
+		if (root_ != nullptr)
+		{
+			stack.push_back(root_.get());
+		}
+		while (!stack.empty())
+		{
+			NodeType* node = stack.back();
+			stack.pop_back();
+			if (node->sub_node_num != Size(node->left.get()) + Size(node->right.get()) + 1)
+			{
+				return false;
+			}
+			if (node->left != nullptr)
+			{
+				stack.push_back(node->left.get());
+			}
+			if (node->right != nullptr)
+			{
+				stack.push_back(node->right.get());
+			}
+		}
+
+		return true;
+	}
+
+	void DelMin()
+	{
+		if (IsEmpty())
+		{
+			return;
+		}
+
+		Min();
+		UniqueNodeType right = std::move(root_->right);
+		alloc_.Free(std::move(root_));
+		root_ = std::move(right);
+	}
+
+	void DelMax()
+	{
+		if (IsEmpty())
+		{
+			return;
+		}
+
+		Max();
+		UniqueNodeType left = std::move(root_->left);
+		alloc_.Free(std::move(root_));
+		root_ = std::move(left);
+	}
+
+	NodeType const*const Min()
+	{
+		if (IsEmpty())
+		{
+			return nullptr;
+		}
+
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			path_.push_back(slot);
+			slot = &(*slot)->left;
+		}
+		Splay();
+
+		return root_.get();
+	}
+
+	NodeType const*const Max()
+	{
+		if (IsEmpty())
+		{
+			return nullptr;
+		}
+
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			path_.push_back(slot);
+			slot = &(*slot)->right;
+		}
+		Splay();
+
+		return root_.get();
+	}
+
+	NodeType const*const Select(int ranking)
+	{
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			int num = Size(node->left.get()) + 1;
+			if (num > ranking)
+			{
+				slot = &node->left;
+			}
+			else if (num < ranking)
+			{
+				ranking -= num;
+				slot = &node->right;
+			}
+			else
+			{
+				SemiSplay();
+				return node;
+			}
+		}
+
+		SemiSplay();
+		return nullptr;
+	}
+
+	template<typename NodeValType>
+	const int Rank(NodeValType&& val)
+	{
+		int rank = 0;
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (compare_(val, node->val))
+			{
+				slot = &node->left;
+			}
+			else if (compare_(node->val, val))
+			{
+				rank += Size(node->left.get()) + 1;
+				slot = &node->right;
+			}
+			else
+			{
+				rank += Size(node->left.get()) + 1;
+				SemiSplay();
+				return rank;
+			}
+		}
+		SemiSplay();
+
+		return 0;
+	}
+
+	// ϸСvalԪظvalش
+	template<typename NodeValType>
+	const int CountLess(const NodeValType& val)
+	{
+		int num = 0;
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (compare_(node->val, val))
+			{
+				num += Size(node->left.get()) + 1;
+				slot = &node->right;
+			}
+			else
+			{
+				slot = &node->left;
+			}
+		}
+		SemiSplay();
+
+		return num;
+	}
+
+	// valСڻȼۣԪظ
+	template<typename NodeValType>
+	const int CountLessEqual(const NodeValType& val)
+	{
+		int num = 0;
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (!compare_(val, node->val))
+			{
+				num += Size(node->left.get()) + 1;
+				slot = &node->right;
+			}
+			else
+			{
+				slot = &node->left;
+			}
+		}
+		SemiSplay();
+
+		return num;
+	}
+
+	// RedBlackBSTһ£ϸСvalԪ
+	template<typename NodeValType>
+	NodeType const*const Floor(NodeValType&& val)
+	{
+		NodeType* floor = nullptr;
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (LessEqual(val, node->val))
+			{
+				slot = &node->left;
+			}
+			else
+			{
+				floor = node;
+				slot = &node->right;
+			}
+		}
+		SemiSplay();
+
+		return floor;
+	}
+
+	// ϸvalСԪ
+	template<typename NodeValType>
+	NodeType const*const Ceiling(NodeValType&& val)
+	{
+		NodeType* ceiling = nullptr;
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (LessEqual(node->val, val))
+			{
+				slot = &node->right;
+			}
+			else
+			{
+				ceiling = node;
+				slot = &node->left;
+			}
+		}
+		SemiSplay();
+
+		return ceiling;
+	}
+
+	// RedBlackBST֣ʵջʱҲջ
+	template<typename TTraversingCb>
+	void MiddleOrderWithRecursion(TTraversingCb&& fun)const
+	{
+		std::vector<NodeType*> stack;
+		NodeType* node = root_.get();
+		while (node != nullptr || !stack.empty())
+		{
+			while (node != nullptr)
+			{
+				stack.push_back(node);
+				node = node->left.get();
+			}
+
+			node = stack.back();
+			stack.pop_back();
+			fun(node->val);
+			node = node->right.get();
+		}
+	}
+
+	template<typename TTraversingCb>
+	void DescendTraverse(TTraversingCb&& fun)const
+	{
+		std::vector<NodeType*> stack;
+		NodeType* node = root_.get();
+		while (node != nullptr || !stack.empty())
+		{
+			while (node != nullptr)
+			{
+				stack.push_back(node);
+				node = node->right.get();
+			}
+
+			node = stack.back();
+			stack.pop_back();
+			fun(node->val);
+			node = node->left.get();
+		}
+	}
+
+	// valչժ£ٰڵչĸӵұ
+	template<typename NodeValType>
+	void Delete(NodeValType&& val)
+	{
+		if (!Access(val))
+		{
+			return;
+		}
+
+		UniqueNodeType left = std::move(root_->left);
+		UniqueNodeType right = std::move(root_->right);
+		alloc_.Free(std::move(root_));
+		if (left == nullptr)
+		{
+			root_ = std::move(right);
+			return;
+		}
+
+		path_.clear();
+		UniqueNodeType* slot = &left;
+		while (*slot != nullptr)
+		{
+			path_.push_back(slot);
+			slot = &(*slot)->right;
+		}
+		Splay();
+
+		left->right = std::move(right);
+		left->sub_node_num = Size(left->left.get()) + Size(left->right.get()) + 1;
+		root_ = std::move(left);
+	}
+
+	// ϸO(N)ؽȫƽԭݻᱻ
+	template<typename TIterator>
+	void BuildFromSorted(TIterator first, TIterator last)
+	{
+		Clear();
+
+		int num = static_cast<int>(std::distance(first, last));
+		root_ = Build(first, num);
+	}
+
+	// ȥؽ
+	template<typename TIterator>
+	void BuildFromUnsorted(TIterator first, TIterator last)
+	{
+		std::vector<RealTType> vals(first, last);
+		std::sort(vals.begin(), vals.end(), compare_);
+		vals.erase(std::unique(vals.begin(), vals.end(), [this](const RealTType& l, const RealTType& r)
+		{
+			return !compare_(l, r) && !compare_(r, l);
+		}), vals.end());
+
+		BuildFromSorted(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+	}
+
+	// ͷŽڵ㣬Ȱתұߣͷʱڵûݹͷź
+	void Clear()
+	{
+		while (root_ != nullptr)
+		{
+			if (root_->left != nullptr)
+			{
+				root_ = RotateRight(std::move(root_));
+				continue;
+			}
+
+			UniqueNodeType right = std::move(root_->right);
+			alloc_.Free(std::move(root_));
+			root_ = std::move(right);
+		}
+	}
+
+	const bool IsEmpty()const noexcept
+	{
+		return root_ == nullptr;
+	}
+
+	const int Size()const noexcept
+	{
+		return Size(root_.get());
+	}
+
+	NodeType const*const GetRoot()const noexcept
+	{
+		return root_.get();
+	}
+
+	const AllocatorType& GetAllocator()const noexcept
+	{
+		return alloc_;
+	}
+
+	const CompareType& GetCompare()const noexcept
+	{
+		return compare_;
+	}
+
+	ConstIterator begin()const
+	{
+		ConstIterator it(root_.get());
+		if (root_ != nullptr)
+		{
+			it.Push(root_.get());
+			it.PushLeftSpine();
+		}
+		return it;
+	}
+
+	ConstIterator end()const
+	{
+		return ConstIterator(root_.get());
+	}
+
+	ConstReverseIterator rbegin()const
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ConstReverseIterator rend()const
+	{
+		return ConstReverseIterator(begin());
+	}
+
+	// һСvalԪ
+	template<typename NodeValType>
+	ConstIterator LowerBound(const NodeValType& val)const
+	{
+		ConstIterator it(root_.get());
+		int found_depth = 0;
+
+		const NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			it.Push(node);
+			if (compare_(node->val, val))
+			{
+				node = node->right.get();
+			}
+			else
+			{
+				found_depth = it.Depth();
+				node = node->left.get();
+			}
+		}
+		it.Truncate(found_depth);
+
+		return it;
+	}
+
+	// һvalԪ
+	template<typename NodeValType>
+	ConstIterator UpperBound(const NodeValType& val)const
+	{
+		ConstIterator it(root_.get());
+		int found_depth = 0;
+
+		const NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			it.Push(node);
+			if (compare_(val, node->val))
+			{
+				found_depth = it.Depth();
+				node = node->left.get();
+			}
+			else
+			{
+				node = node->right.get();
+			}
+		}
+		it.Truncate(found_depth);
+
+		return it;
+	}
+
+	// [low, high]֮ԪأO( + k)
+	template<typename LowValType, typename HighValType>
+	RangeType Range(const LowValType& low, const HighValType& high)const
+	{
+		if (compare_(high, low))
+		{
+			return RangeType{ end(), end() };
+		}
+
+		return RangeType{ LowerBound(low), UpperBound(high) };
+	}
+
+	template<typename NodeValType>
+	RangeType EqualRange(const NodeValType& val)const
+	{
+		return RangeType{ LowerBound(val), UpperBound(val) };
+	}
+
+private:
+	// valʵĽڵչҵʱval
+	template<typename NodeValType>
+	const bool Access(const NodeValType& val)
+	{
+		path_.clear();
+		UniqueNodeType* slot = &root_;
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			path_.push_back(slot);
+			if (compare_(val, node->val))
+			{
+				slot = &node->left;
+			}
+			else if (compare_(node->val, val))
+			{
+				slot = &node->right;
+			}
+			else
+			{
+				Splay();
+				return true;
+			}
+		}
+
+		Splay();
+		return false;
+	}
+
+	// path_һϵĽڵתpath_[0]λã
+	// path_[i + 1]path_[i]ָڵӻӡ
+	// ڵ븸ڵͬʱת游zig-zigתڵ㣨zig-zag·ϵĽڵȴԼ
+	void Splay()
+	{
+		int x = static_cast<int>(path_.size()) - 1;
+		while (x >= 2)
+		{
+			UniqueNodeType& parent = *path_[x - 1];
+			UniqueNodeType& grand = *path_[x - 2];
+			const bool x_left = path_[x] == &parent->left;
+			const bool parent_left = path_[x - 1] == &grand->left;
+			if (x_left == parent_left)
+			{
+				grand = Rotate(std::move(grand), parent_left);
+				grand = Rotate(std::move(grand), x_left);
+			}
+			else
+			{
+				parent = Rotate(std::move(parent), x_left);
+				grand = Rotate(std::move(grand), parent_left);
+			}
+			x -= 2;
+		}
+
+		if (x == 1)
+		{
+			UniqueNodeType& top = *path_[0];
+			top = Rotate(std::move(top), path_[1] == &top->left);
+		}
+	}
+
+	// չͬʱֻת游ȻӸڵϣڵֻԼһȣת
+	void SemiSplay()
+	{
+		int x = static_cast<int>(path_.size()) - 1;
+		while (x >= 2)
+		{
+			UniqueNodeType& parent = *path_[x - 1];
+			UniqueNodeType& grand = *path_[x - 2];
+			const bool x_left = path_[x] == &parent->left;
+			const bool parent_left = path_[x - 1] == &grand->left;
+			if (x_left == parent_left)
+			{
+				grand = Rotate(std::move(grand), parent_left);
+			}
+			else
+			{
+				parent = Rotate(std::move(parent), x_left);
+				grand = Rotate(std::move(grand), parent_left);
+			}
+			x -= 2;
+		}
+	}
+
+	// ӽڵ㣨leftΪtrueӽڵת
+	static UniqueNodeType Rotate(UniqueNodeType node, bool left)noexcept
+	{
+		return left ? RotateRight(std::move(node)) : RotateLeft(std::move(node));
+	}
+
+	static UniqueNodeType RotateRight(UniqueNodeType node)noexcept
+	{
+		UniqueNodeType left = std::move(node->left);
+		node->left = std::move(left->right);
+		left->sub_node_num = node->sub_node_num;
+		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		left->right = std::move(node);
+
+		return left;
+	}
+
+	static UniqueNodeType RotateLeft(UniqueNodeType node)noexcept
+	{
+		UniqueNodeType right = std::move(node->right);
+		node->right = std::move(right->left);
+		right->sub_node_num = node->sub_node_num;
+		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		right->left = std::move(node);
+
+		return right;
+	}
+
+	// еԪأмԪΪ
+	template<typename TIterator>
+	UniqueNodeType Build(TIterator& it, int num)
+	{
+		if (num == 0)
+		{
+			return nullptr;
+		}
+
+		int left_num = (num - 1) / 2;
+
+		UniqueNodeType left = Build(it, left_num);
+		UniqueNodeType node = alloc_.New(*it);
+		++it;
+		node->left = std::move(left);
+		node->right = Build(it, num - 1 - left_num);
+		node->sub_node_num = num;
+
+		return node;
+	}
+
+	static const int Size(const NodeType* node)noexcept
+	{
+		if (node == nullptr)
+		{
+			return 0;
+		}
+
+		return node->sub_node_num;
+	}
+
+	// ͬ͵ֵTԼ==RedBlackBSTһ
+	const bool IsEqual(const RealTType& key, const RealTType& val)const noexcept
+	{
+		return key == val;
+	}
+
+	template<typename TKey>
+	const bool IsEqual(const TKey& key, const RealTType& val)const noexcept
+	{
+		return !compare_(key, val) && !compare_(val, key);
+	}
+
+	// ĬϱȽͬ͵ֵTԼ<=ɱȽƳ
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right)const noexcept
+	{
+		return LessEqual(left, right, std::integral_constant<bool,
+			std::is_same<TCompare, std::less<RealTType>>::value && std::is_same<TLeft, RealTType>::value && std::is_same<TRight, RealTType>::value>());
+	}
+
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::true_type)const noexcept
+	{
+		return left <= right;
+	}
+
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::false_type)const noexcept
+	{
+		return !compare_(right, left);
+	}
+
+private:
+	TCompare compare_;
+	AllocatorType alloc_;
+	UniqueNodeType root_;
+	// һβҾӣÿβҶڴ
+	std::vector<UniqueNodeType*> path_;
+};
+
+#endif // !SPLAY_TREE_H_
@@ -2,29 +2,107 @@
 #define TREE_H_
 
 #include "node.h"
+#include "tree_iterator.h"
+#include "frozen_tree.h"
+#include "tree_stats.h"
 
 #include <memory>
 #include <stack>
-
-template<typename T>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <thread>
+
+// TCompareǴis_transparentıȽʱѯɾֱӴkey
+// ȽҪͬʱ֧(key, T)(T, key)ֲ˳
+// TAugmentǽڵϵľۺϲԣaugment.hsub_node_numһͬһ·ά
+template<typename T, template<typename> class TAllocator = HeapNodeAllocator,
+	typename TCompare = std::less<std::remove_reference_t<std::decay_t<T>>>,
+	typename TAugment = NoAugment<std::remove_reference_t<std::decay_t<T>>>>
 class RedBlackBST
 {
 public:
 	using RealTType = std::remove_reference_t<std::decay_t<T>>;
-	using NodeType = Node<RealTType>;
-	using UniqueNodeType = std::unique_ptr<NodeType>;
+	using NodeType = Node<RealTType, TAllocator, TAugment>;
+	using UniqueNodeType = typename NodeType::UniqueNodeType;
+	using AllocatorType = TAllocator<NodeType>;
+	using CompareType = TCompare;
+	using AugmentType = TAugment;
+	using AugmentValueType = typename TAugment::ValueType;
+	using ConstIterator = TreeIterator<NodeType>;
+	using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+	using RangeType = IteratorRange<ConstIterator>;
+
+	using value_type = RealTType;
+	using const_iterator = ConstIterator;
+	using iterator = ConstIterator;
+	using const_reverse_iterator = ConstReverseIterator;
+	using reverse_iterator = ConstReverseIterator;
 
 	RedBlackBST() :root_(nullptr)
 	{
 	}
 
-	~RedBlackBST() = default;
+	explicit RedBlackBST(const AllocatorType& alloc) :alloc_(alloc), root_(nullptr)
+	{
+	}
+
+	explicit RedBlackBST(const CompareType& compare, const AllocatorType& alloc = AllocatorType()) :compare_(compare), alloc_(alloc), root_(nullptr)
+	{
+	}
+
+	~RedBlackBST()
+	{
+		alloc_.Release(std::move(root_));
+	}
 
 	RedBlackBST(const RedBlackBST&) = delete;
 	RedBlackBST& operator=(const RedBlackBST&) = delete;
 
-	RedBlackBST(RedBlackBST&&) = delete;
-	RedBlackBST& operator=(RedBlackBST&&) = delete;
+	// ƶָֻ롢ȽͷӶO(1)
+	// ƶһµķΪԿɼʹãҲƶڵ
+	RedBlackBST(RedBlackBST&& other) :root_(nullptr)
+	{
+		Swap(other);
+	}
+
+	RedBlackBST& operator=(RedBlackBST&& other)
+	{
+		if (&other != this)
+		{
+			RedBlackBST temp(std::move(other));
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	void Swap(RedBlackBST& other)noexcept
+	{
+		std::swap(compare_, other.compare_);
+		std::swap(alloc_, other.alloc_);
+		root_.swap(other.root_);
+		std::swap(multiset_, other.multiset_);
+	}
+
+	// ṹƳһɫ;ۺֱֵհᣬȽϣӶO(N)
+	// ʹµķ뱾ڵء
+	// thread_num1ʱΪ0ʱȡӲ߳ǰĴ̸߳ƣ̸߳һµķ
+	// ֻĽڵɸķͷʱHeapNodeAllocatorŲУ˻Ϊ̸߳
+	RedBlackBST Clone(int thread_num = 1)const
+	{
+		RedBlackBST result(compare_);
+		result.multiset_ = multiset_;
+		int parallel_depth = 0;
+		if (result.alloc_ == AllocatorType())
+		{
+			parallel_depth = ParallelDepth(thread_num);
+		}
+
+		result.root_ = Clone(root_.get(), result.alloc_, parallel_depth);
+		return result;
+	}
 
 public:
 	template<typename NodeValType,
@@ -37,8 +115,101 @@ public:
 	>
 	void Put(NodeValType&& val)
 	{
-		root_ = Put(std::move(root_), std::forward<NodeValType>(val));
+		UniqueNodeType* path[kMaxPathLen];
+		int depth = 0;
+
+		UniqueNodeType* slot = FindSlot(val, path, depth);
+		if (slot == nullptr)
+		{
+			// ؼģʽֻ1pathһȵĽڵ
+			if (multiset_)
+			{
+				for (int i = 0; i < depth; ++i)
+				{
+					++(*path[i])->sub_node_num;
+				}
+			}
+			return;
+		}
+
+		*slot = alloc_.New(std::forward<NodeValType>(val));
+		Pull(slot->get());
+
+		FixUpAfterPut(path, depth);
+		root_->color = NodeType::BLACK;
+	}
+
+	// ʾĲ룬hintʼҲλãָԪصĵֵѴʱָеԪء
+	// hintֻ·һȱȽϣҵval£valhintԽȽϴԽ٣
+	// λO(1)αȽϣhintΪend()ʱԪؿʼʺϰ˳׷ӡ
+	// ·ۼӼO(logN)ָֻʣٱȽϡ
+	// صĵֱΪһβhinthintǱϴ޸֮ȡõĵ
+	template<typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	ConstIterator Put(const ConstIterator& hint, NodeValType&& val)
+	{
+		ConstIterator it;
+		if (root_ == nullptr)
+		{
+			Put(std::forward<NodeValType>(val));
+			it = begin();
+			return it;
+		}
+
+		// ʱ˳·ϵӣpath[it.Depth()]ǲλ
+		UniqueNodeType* path[kMaxPathLen];
+		if (FingerSearch(hint, val, it, path))
+		{
+			if (multiset_)
+			{
+				for (int i = 0; i < it.Depth(); ++i)
+				{
+					++const_cast<NodeType*>(it.NodeAt(i))->sub_node_num;
+				}
+			}
+			return it;
+		}
+
+		const int depth = it.Depth();
+		UniqueNodeType* slot = path[depth];
+		*slot = alloc_.New(std::forward<NodeValType>(val));
+		NodeType* added = slot->get();
+		Pull(added);
+
+		const int changed = FixUpAfterPut(path, depth);
 		root_->color = NodeType::BLACK;
+
+		// changedϵ·ûб仯ֻҵ½ڵ
+		it.Truncate(changed);
+		const NodeType* node = path[changed]->get();
+		while (node != added)
+		{
+			it.Push(node);
+			TREE_STATS_INC(put_compare);
+			node = compare_(added->val, node->val) ? node->left.get() : node->right.get();
+		}
+		it.Push(added);
+
+		return it;
+	}
+
+	// hintʼvalҲʱend()ȽϴPut(hint, val)ͬ
+	template<typename NodeValType>
+	ConstIterator Find(const ConstIterator& hint, const NodeValType& val)const noexcept
+	{
+		ConstIterator it;
+		if (root_ == nullptr || !FingerSearch(hint, val, it, nullptr))
+		{
+			return end();
+		}
+
+		return it;
 	}
 
 	template<typename NodeValType>
@@ -88,23 +259,63 @@ public:
 		return IsSizeConsistent(root_.get());
 	}
 
-	void DelMin()
+	// ؼģʽPutȼ۵ֵʱٺԣֻѸýڵ1DeleteDelMinDelMaxڻظʱֻ1
+	// ߶ֻز·ڵ㣬Ҳתɫ
+	// ֶΣsub_node_numвĲ־ǽڵڵ㲻
+	// SizeRankSelectCountLessȰRangeͱÿֵֻһΣCountȡá
+	// SplitJoinCloneʱڵƶеȼԪصȡ󡢽ȡС
+	// ļظдÿֵFreezeĸÿֵֻһ
+	// ۺֵ޷ʾۺϵܿرʱظԪغϲΪһӶO(N)
+	void SetMultiset(bool enable)
 	{
-		if (IsEmpty())
+		static_assert(!IsAugmented<TAugment>::value, "multiset mode is not supported by augmented trees");
+
+		multiset_ = enable;
+		if (multiset_ || root_ == nullptr)
 		{
 			return;
 		}
 
-		if (!IsRed(root_->left.get()) && !IsRed(root_->right.get()))
+		std::vector<UniqueNodeType> nodes;
+		nodes.reserve(Size());
+		Flatten(std::move(root_), nodes);
+
+		auto node_it = nodes.begin();
+		auto make = [&node_it]()
 		{
-			root_->color = NodeType::RED;
-		}
+			UniqueNodeType node = std::move(*node_it);
+			node->sub_node_num = 1;
+			++node_it;
+			return node;
+		};
+		BuildRoot(make, static_cast<int>(nodes.size()));
+	}
 
-		root_ = DelMin(std::move(root_));
-		if (!IsEmpty())
+	const bool IsMultiset()const noexcept
+	{
+		return multiset_;
+	}
+
+	// valʱΪ0ǶؼģʽʱΪ1
+	template<typename NodeValType>
+	const int Count(const NodeValType& val)const noexcept
+	{
+		NodeType const*const node = Get(val);
+		return node == nullptr ? 0 : OwnNum(node);
+	}
+
+	void DelMin()
+	{
+		if (IsEmpty())
 		{
-			root_->color = NodeType::BLACK;
+			return;
 		}
+		if (multiset_ && DecreaseCount(Min(root_.get())->val) > 1)
+		{
+			return;
+		}
+
+		alloc_.Free(DetachMin(root_));
 	}
 
 	void DelMax()
@@ -113,12 +324,44 @@ public:
 		{
 			return;
 		}
+		if (multiset_ && DecreaseCount(Max(root_.get())->val) > 1)
+		{
+			return;
+		}
 		if (!IsRed(root_->left.get())&& !IsRed(root_->right.get()))
 		{
 			root_->color = NodeType::RED;
 		}
 
-		root_ = DelMax(std::move(root_));
+		UniqueNodeType* path[kMaxPathLen];
+		int depth = 0;
+		int changed_depth = kMaxPathLen;
+
+		UniqueNodeType* slot = &root_;
+		while (true)
+		{
+			if (IsRed((*slot)->left.get()))
+			{
+				*slot = RotateRight(std::move(*slot));
+				changed_depth = std::min(changed_depth, depth);
+			}
+			if ((*slot)->right == nullptr)
+			{
+				break;
+			}
+			if (!IsRed((*slot)->right.get()) && !IsRed((*slot)->right->left.get()))
+			{
+				*slot = MoveRedRight(std::move(*slot));
+				changed_depth = std::min(changed_depth, depth);
+			}
+
+			path[depth++] = slot;
+			slot = &(*slot)->right;
+		}
+		const int removed = (*slot)->sub_node_num;
+		alloc_.Free(std::move(*slot));
+
+		FixUpAfterDelete(path, depth, changed_depth, removed);
 
 		if (!IsEmpty())
 		{
@@ -147,6 +390,186 @@ public:
 		return Rank(root_.get(), std::forward<NodeValType>(val));
 	}
 
+	// ϸСvalԪظvalش
+	template<typename NodeValType>
+	const int CountLess(const NodeValType& val)const noexcept
+	{
+		int num = 0;
+		NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			if (compare_(node->val, val))
+			{
+				num += Size(node->left.get()) + OwnNum(node);
+				node = node->right.get();
+			}
+			else
+			{
+				node = node->left.get();
+			}
+		}
+
+		return num;
+	}
+
+	// valСڻȼۣԪظ
+	template<typename NodeValType>
+	const int CountLessEqual(const NodeValType& val)const noexcept
+	{
+		int num = 0;
+		NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			if (!compare_(val, node->val))
+			{
+				num += Size(node->left.get()) + OwnNum(node);
+				node = node->right.get();
+			}
+			else
+			{
+				node = node->left.get();
+			}
+		}
+
+		return num;
+	}
+
+	// ľۺֵ
+	AugmentValueType Aggregate()const
+	{
+		static_assert(IsAugmented<TAugment>::value, "Aggregate needs an augmented tree");
+		return AugmentOf(root_.get());
+	}
+
+	// [low, high]Ԫذľۺֵҵڵ߽ڵ㣬
+	// ߽½߽ڲֱȡڵϵľۺֵO(logN)
+	template<typename TLow, typename THigh>
+	AugmentValueType Aggregate(const TLow& low, const THigh& high)const
+	{
+		static_assert(IsAugmented<TAugment>::value, "Aggregate needs an augmented tree");
+
+		const NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			if (compare_(node->val, low))
+			{
+				node = node->right.get();
+			}
+			else if (compare_(high, node->val))
+			{
+				node = node->left.get();
+			}
+			else
+			{
+				break;
+			}
+		}
+		if (node == nullptr)
+		{
+			return TAugment::Identity();
+		}
+
+		// вСlowĲ֣ӴСռȡķǰ
+		AugmentValueType left_aug = TAugment::Identity();
+		for (const NodeType* cur = node->left.get(); cur != nullptr;)
+		{
+			if (compare_(cur->val, low))
+			{
+				cur = cur->right.get();
+				continue;
+			}
+
+			left_aug = TAugment::Combine(TAugment::Combine(TAugment::FromVal(cur->val), AugmentOf(cur->right.get())), left_aug);
+			cur = cur->left.get();
+		}
+
+		// вhighĲ֣Сռ
+		AugmentValueType right_aug = TAugment::Identity();
+		for (const NodeType* cur = node->right.get(); cur != nullptr;)
+		{
+			if (compare_(high, cur->val))
+			{
+				cur = cur->left.get();
+				continue;
+			}
+
+			right_aug = TAugment::Combine(right_aug, TAugment::Combine(AugmentOf(cur->left.get()), TAugment::FromVal(cur->val)));
+			cur = cur->right.get();
+		}
+
+		return TAugment::Combine(TAugment::Combine(left_aug, TAugment::FromVal(node->val)), right_aug);
+	}
+
+	// [first, last]֮䣨1ʼֺԣԪصľۺֵС߽½O(logN)
+	AugmentValueType AggregateByRank(int first, int last)const
+	{
+		static_assert(IsAugmented<TAugment>::value, "AggregateByRank needs an augmented tree");
+
+		first = std::max(first, 1);
+		last = std::min(last, Size());
+		if (first > last)
+		{
+			return TAugment::Identity();
+		}
+
+		const NodeType* node = root_.get();
+		int rank = 0;
+		int offset = 0;
+		while (true)
+		{
+			rank = offset + Size(node->left.get()) + 1;
+			if (rank < first)
+			{
+				offset = rank;
+				node = node->right.get();
+			}
+			else if (rank > last)
+			{
+				node = node->left.get();
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		// rank - firstԪ
+		AugmentValueType left_aug = TAugment::Identity();
+		int num = rank - first;
+		for (const NodeType* cur = node->left.get(); num > 0;)
+		{
+			const int right_num = Size(cur->right.get());
+			if (right_num >= num)
+			{
+				cur = cur->right.get();
+				continue;
+			}
+
+			left_aug = TAugment::Combine(TAugment::Combine(TAugment::FromVal(cur->val), AugmentOf(cur->right.get())), left_aug);
+			num -= right_num + 1;
+			cur = cur->left.get();
+		}
+
+		// ǰlast - rankԪ
+		AugmentValueType right_aug = TAugment::Identity();
+		num = last - rank;
+		for (const NodeType* cur = node->right.get(); num > 0;)
+		{
+			const int left_num = Size(cur->left.get());
+			if (left_num >= num)
+			{
+				cur = cur->left.get();
+				continue;
+			}
+
+			right_aug = TAugment::Combine(right_aug, TAugment::Combine(AugmentOf(cur->left.get()), TAugment::FromVal(cur->val)));
+			num -= left_num + 1;
+			cur = cur->right.get();
+		}
+
+		return TAugment::Combine(TAugment::Combine(left_aug, TAugment::FromVal(node->val)), right_aug);
+	}
+
 	template<typename NodeValType>
 	NodeType const*const Floor(NodeValType&& val)const noexcept
 	{
@@ -186,88 +609,463 @@ public:
 	template<typename NodeValType>
 	void Delete(NodeValType&& val)
 	{
-		if (!IsExists(std::forward<NodeValType>(val)))
+		if (multiset_)
 		{
-			return;
+			if (DecreaseCount(val) != 1)
+			{
+				return;
+			}
 		}
-
-		if (!IsRed(root_->left.get()) && !IsRed(root_->right.get()))
+		else if (!IsExists(std::forward<NodeValType>(val)))
 		{
-			root_->color = NodeType::RED;
+			return;
 		}
 
-		root_ = Delete(std::move(root_), std::forward<NodeValType>(val));
+		alloc_.Free(Detach(val));
+	}
 
-		if (!IsEmpty())
+	// ޸Ԫصֵֵǰͺ֮ʱԭظд
+	// һڵժֵٹһȥͷź·ڵ㡣
+	// old_valڻnew_valѴʱ޸Ĳfalse
+	// ؼģʽֻ޸һԪأold_valظnew_valѴʱȼDeletePutֻ
+	template<typename OldValType, typename NodeValType,
+		typename = typename std::enable_if_t<
+		std::is_same<
+		RealTType,
+		std::remove_reference_t<std::decay_t<NodeValType>>
+		>::value
+	>
+	>
+	const bool UpdateKey(const OldValType& old_val, NodeValType&& new_val)
+	{
+		if (multiset_)
 		{
-			root_->color = NodeType::BLACK;
+			const int num = Count(old_val);
+			if (num == 0)
+			{
+				return false;
+			}
+			if (num > 1 || IsExists(new_val))
+			{
+				Delete(old_val);
+				Put(std::forward<NodeValType>(new_val));
+				return true;
+			}
 		}
-	}
 
-	const bool IsEmpty()const noexcept
-	{
-		return root_ == nullptr;
-	}
+		const NodeType* prev = nullptr;
+		const NodeType* next = nullptr;
 
-	const int Size()const noexcept
-	{
-		return Size(root_.get());
-	}
+		// ԭظдȵľۺֵҲҪ¼㣬ۺʱ¼
+		NodeType* ancestors[kMaxPathLen];
+		int ancestor_num = 0;
 
-	NodeType const*const GetRoot()const noexcept
-	{
-		if (root_ == nullptr)
+		NodeType* node = root_.get();
+		while (node != nullptr)
 		{
-			return nullptr;
+			if (IsAugmented<TAugment>::value)
+			{
+				ancestors[ancestor_num++] = node;
+			}
+
+			if (compare_(old_val, node->val))
+			{
+				next = node;
+				node = node->left.get();
+			}
+			else if (compare_(node->val, old_val))
+			{
+				prev = node;
+				node = node->right.get();
+			}
+			else
+			{
+				break;
+			}
 		}
-		return root_.get();
-	}
 
-private:
+		if (node == nullptr || !IsEqual(old_val, node->val))
+		{
+			return false;
+		}
 
-	template<typename NodeValType>
-	UniqueNodeType Put(UniqueNodeType node, NodeValType&& param)
+		if (node->left != nullptr)
+		{
+			prev = Max(node->left.get());
+		}
+		if (node->right != nullptr)
+		{
+			next = Min(node->right.get());
+		}
+
+		if ((prev == nullptr || compare_(prev->val, new_val)) && (next == nullptr || compare_(new_val, next->val)))
+		{
+			node->val = std::forward<NodeValType>(new_val);
+			for (int i = ancestor_num - 1; i >= 0; --i)
+			{
+				Pull(ancestors[i]);
+			}
+			return true;
+		}
+
+		// һʱȵֵռסλãﰴȽϹϵж϶ǰ==
+		UniqueNodeType* path[kMaxPathLen];
+		int depth = 0;
+		if (FindSlot(new_val, path, depth) == nullptr)
+		{
+			return false;
+		}
+
+		UniqueNodeType detached = Detach(old_val);
+		detached->val = std::forward<NodeValType>(new_val);
+		Attach(std::move(detached));
+
+		return true;
+	}
+
+	// ϸO(N)ؽԭݻᱻա
+	// ؼģʽֻǵݼȵһκϲһڵ
+	template<typename TIterator>
+	void BuildFromSorted(TIterator first, TIterator last)
 	{
-		if (node == nullptr)
+		Clear();
+
+		int height = 0;
+		root_ = BuildSorted(first, last, height);
+	}
+
+	// ȥؽؼģʽ²ȥ
+	template<typename TIterator>
+	void BuildFromUnsorted(TIterator first, TIterator last)
+	{
+		std::vector<RealTType> vals(first, last);
+		std::sort(vals.begin(), vals.end(), compare_);
+		if (!multiset_)
+		{
+			vals.erase(std::unique(vals.begin(), vals.end(), [this](const RealTType& l, const RealTType& r)
+			{
+				return !compare_(l, r) && !compare_(r, l);
+			}), vals.end());
+		}
+
+		BuildFromSorted(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+	}
+
+	// ǰֻFrozenRedBlackBST֮Ա޸Ĳᷴӳĸ
+	FrozenRedBlackBST<RealTType, TCompare> Freeze()const
+	{
+		return FrozenRedBlackBST<RealTType, TCompare>(begin(), end(), compare_);
+	}
+
+	// 룬ѴڵֵԼظֵȳֵģԣؼģʽۼӵϡ
+	// СʱӸʼýڵֵгΣֱƴӣ
+	// ûֵԭӶO(K * log(N / K + 1))ԭнڵֵ鲢ؽһΣӶO(N + K)
+	template<typename TIterator>
+	void PutBatch(TIterator first, TIterator last)
+	{
+		std::vector<RealTType> vals(first, last);
+		std::stable_sort(vals.begin(), vals.end(), compare_);
+		if (!multiset_)
 		{
-			return std::make_unique<NodeType>(std::forward<NodeValType>(param));
+			vals.erase(std::unique(vals.begin(), vals.end(), [this](const RealTType& l, const RealTType& r)
+			{
+				return !compare_(l, r) && !compare_(r, l);
+			}), vals.end());
 		}
-		if (param < node->val)
+
+		if (vals.empty())
 		{
-			node->left = Put(std::move(node->left), std::forward<NodeValType>(param));
+			return;
 		}
-		else if (node->val < param)
+
+		const int num = Size();
+		if (static_cast<int>(vals.size()) < num)
 		{
-			node->right = Put(std::move(node->right), std::forward<NodeValType>(param));
+			int height = 0;
+			root_ = MergeSorted(std::move(root_), BlackHeight(root_.get()),
+				std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()), height);
+			root_->color = NodeType::BLACK;
+			return;
 		}
-		else
+
+		std::vector<UniqueNodeType> old_nodes;
+		old_nodes.reserve(num);
+		Flatten(std::move(root_), old_nodes);
+
+		// ԭнڵֱӸãֻΪֵڵ
+		std::vector<UniqueNodeType> nodes;
+		nodes.reserve(old_nodes.size() + vals.size());
+		auto old_it = old_nodes.begin();
+		for (auto& val : vals)
 		{
-			//std::cout << "same val" << std::endl;
+			while (old_it != old_nodes.end() && compare_((*old_it)->val, val))
+			{
+				nodes.push_back(std::move(*old_it));
+				++old_it;
+			}
+			if (old_it != old_nodes.end() && !compare_(val, (*old_it)->val))
+			{
+				if (multiset_)
+				{
+					++(*old_it)->sub_node_num;
+				}
+				continue;
+			}
+			if (multiset_ && !nodes.empty() && !compare_(nodes.back()->val, val))
+			{
+				++nodes.back()->sub_node_num;
+				continue;
+			}
+			nodes.push_back(alloc_.New(std::move(val)));
 		}
+		std::move(old_it, old_nodes.end(), std::back_inserter(nodes));
 
-		// ӽڵǺڵ㣬ӽڵǺڽڵ㣬Ҫת
-		if (IsRed(node->right.get()) && !IsRed(node->left.get()))
+		auto node_it = nodes.begin();
+		auto make = [&node_it]()
 		{
-			node = RotateLeft(std::move(node));
+			UniqueNodeType node = std::move(*node_it);
+			++node_it;
+			return node;
+		};
+		BuildRoot(make, static_cast<int>(nodes.size()));
+	}
+
+	// ѲСkeyԪƵrightУֻСkeyԪأrightԭеݱա
+	// keyĲ·гO(logN)ٰڸߴӵ͵ƴӣܸӶO(logN)
+	// rightñķͶؼģʽڵֱӹҵrightϣͷź·
+	template<typename TKey>
+	void Split(const TKey& key, RedBlackBST& right)
+	{
+		if (&right == this)
+		{
+			return;
 		}
 
-		// ӽڵǺڵͬʱӽڵӽڵҲǺڵ㣬Ҫת
-		if (IsRed(node->left.get()) && IsRed(node->left->left.get()))
+		right.Clear();
+		right.alloc_ = alloc_;
+		right.multiset_ = multiset_;
+
+		const int black_height = BlackHeight(root_.get());
+		UniqueNodeType left_root;
+		UniqueNodeType equal;
+		UniqueNodeType right_root;
+		int left_height = 0;
+		int right_height = 0;
+		Split(std::move(root_), black_height, key, left_root, left_height, equal, right_root, right_height);
+
+		// keyĽڵҰߵСֵ
+		if (equal != nullptr)
 		{
-			node = RotateRight(std::move(node));
+			int height = 0;
+			right_root = Join(nullptr, 0, std::move(equal), std::move(right_root), right_height, height);
 		}
 
-		// ӽڵӽڵ㶼Ǻڵ㣬Ҫ任ɫ
-		if (IsRed(node->left.get()) && IsRed(node->right.get()))
+		// ĸǺڵ㣬Ⱦںڸͳһ1Ӱƽ
+		if (left_root != nullptr)
 		{
-			FlipColor(node.get());
+			left_root->color = NodeType::BLACK;
+		}
+		if (right_root != nullptr)
+		{
+			right_root->color = NodeType::BLACK;
 		}
 
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		root_ = std::move(left_root);
+		right.root_ = std::move(right_root);
+	}
 
-		return node;
+	// rightеԪȫƵrightΪҪԪضСrightеԪأ޸Ĳfalse
+	// ժrightСڵΪָӺڸ߽ϴһ½ƴӣӶO(logN)
+	// ķͬԶռһڵأֻһǶؼʱڵ㲻ܿ˻ΪϲؽӶO(N)
+	const bool Join(RedBlackBST& right)
+	{
+		if (right.IsEmpty())
+		{
+			return true;
+		}
+		if (&right == this || (!IsEmpty() && !compare_(Max()->val, right.Min()->val)))
+		{
+			return false;
+		}
+
+		if (alloc_ != right.alloc_ || multiset_ != right.multiset_)
+		{
+			std::vector<RealTType> vals;
+			AppendVals(vals, multiset_);
+			right.AppendVals(vals, multiset_);
+			right.Clear();
+			BuildFromSorted(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+			return true;
+		}
+
+		UniqueNodeType node = right.DetachMin(right.root_);
+		const int left_height = BlackHeight(root_.get());
+		const int right_height = BlackHeight(right.root_.get());
+
+		int height = 0;
+		root_ = Join(std::move(root_), left_height, std::move(node), std::move(right.root_), right_height, height);
+
+		return true;
+	}
+
+	// ĽڱУotherĲΪȼ۵Ԫرֵ
+	// ԱĸΪпotherߵ⻥أݹøѽƴ
+	// ӶO(M * log(N / M + 1))MNΪнСͽϴĹģ
+	// ݹǰһ⽻̣߳thread_numΪ0ʱȡӲ߳
+	// Сʱٿ̣߳߳thread_numԶһЩзֲʱɵĺб
+	// н׶ֻƶڵ㣬Ľڵڵ߳ͳһͷţڵزҪ
+	// ķֻͬһǶؼʱڵ㲻ܿ˻Ϊ鲢ؽ
+
+	// 
+	void Union(RedBlackBST& other, int thread_num = 0)
+	{
+		SetOperation(other, thread_num, SetOp::kUnion);
+	}
+
+	// 
+	void Intersection(RedBlackBST& other, int thread_num = 0)
+	{
+		SetOperation(other, thread_num, SetOp::kIntersection);
+	}
+
+	// ֻotherеԪ
+	void Difference(RedBlackBST& other, int thread_num = 0)
+	{
+		SetOperation(other, thread_num, SetOp::kDifference);
+	}
+
+	void Clear()
+	{
+		alloc_.Free(std::move(root_));
+	}
+
+	const bool IsEmpty()const noexcept
+	{
+		return root_ == nullptr;
+	}
+
+	const int Size()const noexcept
+	{
+		return Size(root_.get());
+	}
+
+	NodeType const*const GetRoot()const noexcept
+	{
+		if (root_ == nullptr)
+		{
+			return nullptr;
+		}
+		return root_.get();
+	}
+
+	const AllocatorType& GetAllocator()const noexcept
+	{
+		return alloc_;
+	}
+
+	const CompareType& GetCompare()const noexcept
+	{
+		return compare_;
+	}
+
+	ConstIterator begin()const noexcept
+	{
+		ConstIterator it(root_.get());
+		if (root_ != nullptr)
+		{
+			it.Push(root_.get());
+			it.PushLeftSpine();
+		}
+		return it;
+	}
+
+	ConstIterator end()const noexcept
+	{
+		return ConstIterator(root_.get());
+	}
+
+	ConstReverseIterator rbegin()const noexcept
+	{
+		return ConstReverseIterator(end());
+	}
+
+	ConstReverseIterator rend()const noexcept
+	{
+		return ConstReverseIterator(begin());
+	}
+
+	// һСvalԪ
+	template<typename NodeValType>
+	ConstIterator LowerBound(const NodeValType& val)const noexcept
+	{
+		ConstIterator it(root_.get());
+		int found_depth = 0;
+
+		const NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			it.Push(node);
+			if (compare_(node->val, val))
+			{
+				node = node->right.get();
+			}
+			else
+			{
+				found_depth = it.Depth();
+				node = node->left.get();
+			}
+		}
+		it.Truncate(found_depth);
+
+		return it;
+	}
+
+	// һvalԪ
+	template<typename NodeValType>
+	ConstIterator UpperBound(const NodeValType& val)const noexcept
+	{
+		ConstIterator it(root_.get());
+		int found_depth = 0;
+
+		const NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			it.Push(node);
+			if (compare_(val, node->val))
+			{
+				found_depth = it.Depth();
+				node = node->left.get();
+			}
+			else
+			{
+				node = node->right.get();
+			}
+		}
+		it.Truncate(found_depth);
+
+		return it;
+	}
+
+	// [low, high]֮ԪأO(log n + k)
+	template<typename LowValType, typename HighValType>
+	RangeType Range(const LowValType& low, const HighValType& high)const noexcept
+	{
+		if (compare_(high, low))
+		{
+			return RangeType{ end(), end() };
+		}
+
+		return RangeType{ LowerBound(low), UpperBound(high) };
+	}
+
+	template<typename NodeValType>
+	RangeType EqualRange(const NodeValType& val)const noexcept
+	{
+		return RangeType{ LowerBound(val), UpperBound(val) };
 	}
 
+private:
+
 	template<typename NodeValType>
 	NodeType const*const Get(NodeType* node, NodeValType&& val)const noexcept
 	{
@@ -275,15 +1073,17 @@ private:
 		{
 			return nullptr;
 		}
-		if (val < node->val)
+
+		TREE_STATS_INC(get_compare);
+		if (compare_(val, node->val))
 		{
 			return Get(node->left.get(), std::forward<NodeValType>(val));
 		}
-		else if (node->val < val)
+		else if (compare_(node->val, val))
 		{
 			return Get(node->right.get(), std::forward<NodeValType>(val));
 		}
-		else if (val == node->val)
+		else if (IsEqual(val, node->val))
 		{
 			return node;
 		}
@@ -312,11 +1112,11 @@ private:
 		{
 			return true;
 		}
-		if (min_val != nullptr && (*min_val) >= node->val)
+		if (min_val != nullptr && !compare_(*min_val, node->val))
 		{
 			return false;
 		}
-		if (max_val != nullptr && node->val >= (*max_val))
+		if (max_val != nullptr && !compare_(node->val, *max_val))
 		{
 			return false;
 		}
@@ -362,7 +1162,9 @@ private:
 			return true;
 		}
 
-		if (node->sub_node_num != Size(node->left.get()) + Size(node->right.get()) + 1)
+		// Ƕؼʱÿڵֻ1
+		const int num = node->sub_node_num - Size(node->left.get()) - Size(node->right.get());
+		if (num < 1 || (num > 1 && !multiset_))
 		{
 			return false;
 		}
@@ -370,44 +1172,6 @@ private:
 		return IsSizeConsistent(node->left.get()) && IsSizeConsistent(node->right.get());
 	}
 
-	UniqueNodeType DelMin(UniqueNodeType node)
-	{
-		if (node->left == nullptr)
-		{
-			return nullptr;
-		}
-		if (!IsRed(node->left.get()) && !IsRed(node->left->left.get()))
-		{
-			node = MoveRedLeft(std::move(node));
-		}
-
-		node->left = DelMin(std::move(node->left));
-
-		return Balance(std::move(node));
-	}
-
-	UniqueNodeType DelMax(UniqueNodeType node)
-	{
-		if (IsRed(node->left.get()))
-		{
-			node = RotateRight(std::move(node));
-		}
-
-		if (node->right == nullptr)
-		{
-			return nullptr;
-		}
-
-		if (!IsRed(node->right.get()) && !IsRed(node->right->left.get()))
-		{
-			node = MoveRedRight(std::move(node));
-		}
-
-		node->right = DelMax(std::move(node->right));
-
-		return Balance(std::move(node));
-	}
-
 	NodeType* Min(NodeType* node)const noexcept
 	{
 		if (node == nullptr)
@@ -447,12 +1211,14 @@ private:
 			return nullptr;
 		}
 
-		int num = Size(node->left.get()) + 1;
-		if (num > ranking)
+		const int left_num = Size(node->left.get());
+		if (left_num >= ranking)
 		{
 			return Select(node->left.get(), ranking);
 		}
-		else if (num < ranking)
+
+		const int num = left_num + OwnNum(node);
+		if (num < ranking)
 		{
 			return Select(node->right.get(), ranking - num);
 		}
@@ -467,18 +1233,18 @@ private:
 		{
 			return 0;
 		}
-		if (val < node->val)
+		if (compare_(val, node->val))
 		{
 			return Rank(node->left.get(), std::forward<NodeValType>(val));
 		}
-		else if (node->val < val)
+		else if (compare_(node->val, val))
 		{
 			int rank = Rank(node->right.get(), std::forward<NodeValType>(val));
 			if (rank == 0)
 			{
 				return rank;
 			}
-			return 1 + Size(node->left.get()) + rank;
+			return OwnNum(node) + Size(node->left.get()) + rank;
 		}
 
 		return Size(node->left.get()) + 1;
@@ -492,7 +1258,7 @@ private:
 			return nullptr;
 		}
 
-		if (val <= node->val)
+		if (LessEqual(val, node->val))
 		{
 			return Floor(node->left.get(), std::forward<NodeValType>(val));
 		}
@@ -514,7 +1280,7 @@ private:
 			return nullptr;
 		}
 
-		if (node->val <= val)
+		if (LessEqual(node->val, val))
 		{
 			return Ceiling(node->right.get(), std::forward<NodeValType>(val));
 		}
@@ -663,52 +1429,36 @@ private:
 		}
 	}
 
-	template<typename NodeValType>
-	UniqueNodeType Delete(UniqueNodeType node, NodeValType&& val)
+	// ͬ͵ֵTԼ==ԭΪһ£͸Ƚkeyֻܰȼж
+	const bool IsEqual(const RealTType& key, const RealTType& val)const noexcept
 	{
-		if (node == nullptr)
-		{
-			return nullptr;
-		}
+		return key == val;
+	}
 
-		if (val < node->val)
-		{
-			if (node->left != nullptr && !IsRed(node->left.get()) && !IsRed(node->left->left.get()))
-			{
-				node = MoveRedLeft(std::move(node));
-			}
-			node->left = Delete(std::move(node->left),std::forward<NodeValType>(val));
-		}
-		else
-		{
-			if (IsRed(node->left.get()))
-			{
-				node = RotateRight(std::move(node));
-			}
-			if (val == node->val && node->right == nullptr)
-			{
-				return nullptr;
-			}
-			if (node->right != nullptr && !IsRed(node->right.get()) && !IsRed(node->right->left.get()))
-			{
-				node = MoveRedRight(std::move(node));
-			}
-			if (val == node->val)
-			{
-				NodeType* min_node = Min(node->right.get());
-				if (min_node != nullptr)
-				{
-					node->val = min_node->val;
-					node->right = DelMin(std::move(node->right));
-				}
-			}
-			else
-			{
-				node->right = Delete(std::move(node->right),std::forward<NodeValType>(val));
-			}
-		}
+	template<typename TKey>
+	const bool IsEqual(const TKey& key, const RealTType& val)const noexcept
+	{
+		return !compare_(key, val) && !compare_(val, key);
+	}
+
+	// ĬϱȽͬ͵ֵTԼ<=ɱȽƳ
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right)const noexcept
+	{
+		return LessEqual(left, right, std::integral_constant<bool,
+			std::is_same<TCompare, std::less<RealTType>>::value && std::is_same<TLeft, RealTType>::value && std::is_same<TRight, RealTType>::value>());
+	}
+
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::true_type)const noexcept
+	{
+		return left <= right;
+	}
 
-		return Balance(std::move(node));
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::false_type)const noexcept
+	{
+		return !compare_(right, left);
 	}
 
 	const bool IsRed(NodeType* node)const noexcept
@@ -721,7 +1471,7 @@ private:
 		return node->color == NodeType::RED;
 	}
 
-	const int Size(NodeType* node)const noexcept
+	const int Size(const NodeType* node)const noexcept
 	{
 		if (node == nullptr)
 		{
@@ -731,24 +1481,64 @@ private:
 		return node->sub_node_num;
 	}
 
-	UniqueNodeType RotateRight(UniqueNodeType node)noexcept
+	// ڵвĲ֣Ƕؼģʽʱ1
+	const int OwnNum(const NodeType* node)const noexcept
 	{
-		if (node == nullptr)
+		return multiset_ ? node->sub_node_num - Size(node->left.get()) - Size(node->right.get()) : 1;
+	}
+
+	// ɺӵľۺֵֵ¼ڵľۺֵӵľۺֵѾµ
+	void Pull(NodeType* node)const
+	{
+		Pull(node, IsAugmented<TAugment>());
+	}
+
+	void Pull(NodeType* node, std::true_type)const
+	{
+		AugmentValueType aug = TAugment::FromVal(node->val);
+		if (node->left != nullptr)
 		{
-			return node;
+			aug = TAugment::Combine(node->left->aug, aug);
 		}
-		if (!IsRed(node->left.get()))
+		if (node->right != nullptr)
 		{
-			return node;
+			aug = TAugment::Combine(aug, node->right->aug);
 		}
+		node->aug = std::move(aug);
+	}
 
-		UniqueNodeType tmp = std::move(node->left);
-		node->left = std::move(tmp->right);
-		tmp->sub_node_num = node->sub_node_num;
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+	void Pull(NodeType*, std::false_type)const noexcept
+	{
+	}
+
+	AugmentValueType AugmentOf(const NodeType* node)const
+	{
+		return node == nullptr ? TAugment::Identity() : node->aug;
+	}
+
+	UniqueNodeType RotateRight(UniqueNodeType node)noexcept
+	{
+		if (node == nullptr)
+		{
+			return node;
+		}
+		if (!IsRed(node->left.get()))
+		{
+			return node;
+		}
+
+		TREE_STATS_INC(rotate_right);
+		UniqueNodeType tmp = std::move(node->left);
+		node->left = std::move(tmp->right);
+		// תnodeϷtmpڵ
+		const int moved_num = tmp->sub_node_num - Size(node->left.get());
+		tmp->sub_node_num = node->sub_node_num;
+		node->sub_node_num -= moved_num;
 		tmp->right = std::move(node);
 		tmp->color = tmp->right->color;
 		tmp->right->color = NodeType::RED;
+		Pull(tmp->right.get());
+		Pull(tmp.get());
 
 		return tmp;
 	}
@@ -764,13 +1554,17 @@ private:
 			return node;
 		}
 
+		TREE_STATS_INC(rotate_left);
 		UniqueNodeType tmp = std::move(node->right);
 		node->right = std::move(tmp->left);
+		const int moved_num = tmp->sub_node_num - Size(node->right.get());
 		tmp->sub_node_num = node->sub_node_num;
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		node->sub_node_num -= moved_num;
 		tmp->left = std::move(node);
 		tmp->color = tmp->left->color;
 		tmp->left->color = NodeType::RED;
+		Pull(tmp->left.get());
+		Pull(tmp.get());
 
 		return tmp;
 	}
@@ -787,39 +1581,1047 @@ private:
 		if ((!IsRed(node) && IsRed(node->left.get()) && IsRed(node->right.get())) || 
 			(IsRed(node) && !IsRed(node->left.get()) && !IsRed(node->right.get())))
 		{
+			TREE_STATS_INC(flip_color);
 			node->color = !node->color;
 			node->left->color = !node->left->color;
 			node->right->color = !node->right->color;
 		}
 	}
 
-	UniqueNodeType Balance(UniqueNodeType node)
+	// hintڵĽڵxʼvalӸʼʱ·ͬҵʱitָval
+	// itһڵǲλõĸڵ㡣÷֤ǿա
+	// valxΪx·ϴұȶСxvalЩȴһߣxͬ·
+	// ¶ԽԽҵһСvalģval뿪x·
+	// Сvalʱvalx·ߵxҡֻһȱȽϣһvalľֹͣ
+	// pathΪʱǲ룬ͬʱit·ÿڵڵӣûҵʱpath[it.Depth()]ǲλá
+	// ϱȽʱѾжϹڵȵһֻ࣬ͣλϵҪһ
+	template<typename NodeValType>
+	const bool FingerSearch(const ConstIterator& hint, const NodeValType& val, ConstIterator& it, UniqueNodeType** path)const noexcept
+	{
+		const bool for_put = path != nullptr;
+		auto less = [this, for_put](const auto& l, const auto& r)
+		{
+			if (for_put)
+			{
+				TREE_STATS_INC(put_compare);
+			}
+			else
+			{
+				TREE_STATS_INC(get_compare);
+			}
+			return compare_(l, r);
+		};
+
+		it = hint;
+		if (it.Depth() == 0)
+		{
+			it = ConstIterator(root_.get());
+			it.Push(root_.get());
+			it.PushRightSpine();
+		}
+
+		const NodeType* x = it.Current();
+		const bool greater = less(x->val, val);
+		if (!greater && !less(val, x->val))
+		{
+			return true;
+		}
+
+		// ֻڲʱ޸ģconst
+		auto link = [](const UniqueNodeType& child)
+		{
+			return const_cast<UniqueNodeType*>(&child);
+		};
+
+		int keep = it.Depth();
+		int i = it.Depth() - 2;
+		for (; i >= 0; --i)
+		{
+			const NodeType* ancestor = it.NodeAt(i);
+			const bool from_left = ancestor->left.get() == it.NodeAt(i + 1);
+			if (for_put)
+			{
+				path[i + 1] = link(from_left ? ancestor->left : ancestor->right);
+			}
+			if (from_left != greater)
+			{
+				continue;
+			}
+
+			if (greater ? less(val, ancestor->val) : less(ancestor->val, val))
+			{
+				break;
+			}
+			if (greater ? !less(ancestor->val, val) : !less(val, ancestor->val))
+			{
+				it.Truncate(i + 1);
+				return true;
+			}
+			keep = i + 1;
+		}
+
+		it.Truncate(keep);
+		if (for_put)
+		{
+			path[0] = link(root_);
+			for (int j = 1; j <= i && j < keep; ++j)
+			{
+				const NodeType* parent = it.NodeAt(j - 1);
+				path[j] = link(parent->left.get() == it.NodeAt(j) ? parent->left : parent->right);
+			}
+		}
+
+		const UniqueNodeType* child = greater ? &it.Current()->right : &it.Current()->left;
+		while (*child != nullptr)
+		{
+			const NodeType* node = child->get();
+			if (for_put)
+			{
+				path[it.Depth()] = link(*child);
+			}
+			it.Push(node);
+			if (less(val, node->val))
+			{
+				child = &node->left;
+			}
+			else if (less(node->val, val))
+			{
+				child = &node->right;
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		if (for_put)
+		{
+			path[it.Depth()] = link(*child);
+		}
+		return false;
+	}
+
+	// ҵλò¼·Ѵֵͬʱnullptrʱ·һͬĽڵ
+	template<typename NodeValType>
+	UniqueNodeType* FindSlot(const NodeValType& val, UniqueNodeType** path, int& depth)
+	{
+		return FindSlot(val, &root_, path, depth);
+	}
+
+	// ͬϣslotָʼ
+	template<typename NodeValType>
+	UniqueNodeType* FindSlot(const NodeValType& val, UniqueNodeType* slot, UniqueNodeType** path, int& depth)
 	{
+		while (*slot != nullptr)
+		{
+			NodeType* node = slot->get();
+			TREE_STATS_INC(put_compare);
+			if (compare_(val, node->val))
+			{
+				path[depth++] = slot;
+				slot = &node->left;
+			}
+			else if (compare_(node->val, val))
+			{
+				path[depth++] = slot;
+				slot = &node->right;
+			}
+			else
+			{
+				path[depth++] = slot;
+				return nullptr;
+			}
+		}
+
+		return slot;
+	}
+
+	// ժĽڵ㰴ֵ¹һУڵļ÷֤ûֵͬ
+	void Attach(UniqueNodeType node)
+	{
+		UniqueNodeType* path[kMaxPathLen];
+		int depth = 0;
+
+		UniqueNodeType* slot = FindSlot(node->val, path, depth);
+
+		const int added = node->sub_node_num;
+		node->color = NodeType::RED;
+		Pull(node.get());
+		*slot = std::move(node);
+
+		FixUpAfterPut(path, depth, added);
+		root_->color = NodeType::BLACK;
+	}
+
+	// ժһڵ㲢أ÷֤valڣصĽڵļval
+	// valڽڵʱеСֵͬƵýڵ㣬ʵժµСڵ
+	template<typename NodeValType>
+	UniqueNodeType Detach(const NodeValType& val)
+	{
+		if (!IsRed(root_->left.get()) && !IsRed(root_->right.get()))
+		{
+			root_->color = NodeType::RED;
+		}
+
+		UniqueNodeType* path[kMaxPathLen];
+		int depth = 0;
+		int changed_depth = kMaxPathLen;
+		// ʱvalժµСڵͬ
+		int num = 0;
+
+		UniqueNodeType* slot = &root_;
+		while (true)
+		{
+			if (compare_(val, (*slot)->val))
+			{
+				if ((*slot)->left != nullptr && !IsRed((*slot)->left.get()) && !IsRed((*slot)->left->left.get()))
+				{
+					*slot = MoveRedLeft(std::move(*slot));
+					changed_depth = std::min(changed_depth, depth);
+				}
+
+				path[depth++] = slot;
+				slot = &(*slot)->left;
+				continue;
+			}
+
+			if (IsRed((*slot)->left.get()))
+			{
+				*slot = RotateRight(std::move(*slot));
+				changed_depth = std::min(changed_depth, depth);
+			}
+			if (!compare_((*slot)->val, val) && (*slot)->right == nullptr)
+			{
+				break;
+			}
+			if ((*slot)->right != nullptr && !IsRed((*slot)->right.get()) && !IsRed((*slot)->right->left.get()))
+			{
+				*slot = MoveRedRight(std::move(*slot));
+				changed_depth = std::min(changed_depth, depth);
+			}
+
+			if (!compare_((*slot)->val, val))
+			{
+				// еСֵ棬תΪɾеСڵ
+				NodeType* target = slot->get();
+				const int target_depth = depth;
+				num = OwnNum(target);
+				path[depth++] = slot;
+				slot = DescendToMin(&target->right, path, depth, changed_depth);
+				target->val = std::move((*slot)->val);
+
+				// 水СڵͳһۼtargetʵٵvalȲϲֵ
+				const int min_num = (*slot)->sub_node_num;
+				if (min_num != num)
+				{
+					for (int i = 0; i <= target_depth; ++i)
+					{
+						(*path[i])->sub_node_num += min_num - num;
+					}
+				}
+				break;
+			}
+
+			path[depth++] = slot;
+			slot = &(*slot)->right;
+		}
+		UniqueNodeType node = std::move(*slot);
+
+		FixUpAfterDelete(path, depth, changed_depth, node->sub_node_num);
+		if (num != 0)
+		{
+			node->sub_node_num = num;
+		}
+
+		if (!IsEmpty())
+		{
+			root_->color = NodeType::BLACK;
+		}
+
+		return node;
+	}
+
+	// ؼģʽvalظʱ1ֻĲ·ϵļṹ
+	// ؼǰʱ0
+	template<typename NodeValType>
+	const int DecreaseCount(const NodeValType& val)noexcept
+	{
+		NodeType* path[kMaxPathLen];
+		int depth = 0;
+
+		NodeType* node = root_.get();
+		while (node != nullptr)
+		{
+			path[depth++] = node;
+			if (compare_(val, node->val))
+			{
+				node = node->left.get();
+			}
+			else if (compare_(node->val, val))
+			{
+				node = node->right.get();
+			}
+			else
+			{
+				break;
+			}
+		}
 		if (node == nullptr)
 		{
-			return nullptr;
+			return 0;
 		}
 
+		const int num = OwnNum(node);
+		if (num > 1)
+		{
+			for (int i = 0; i < depth; ++i)
+			{
+				--path[i]->sub_node_num;
+			}
+		}
+
+		return num;
+	}
+
+	// Ƿ˽ṹɫ
+	const bool Balance(UniqueNodeType& node)
+	{
+		TREE_STATS_INC(balance);
+		bool changed = false;
+
 		if (IsRed(node->right.get()))
 		{
 			node = RotateLeft(std::move(node));
+			changed = true;
 		}
 
 		if (IsRed(node->left.get()) && IsRed(node->left->left.get()))
 		{
 			node = RotateRight(std::move(node));
+			changed = true;
 		}
 
 		if (IsRed(node->left.get())&& IsRed(node->right.get()))
 		{
 			FlipColor(node.get());
+			changed = true;
 		}
 
-		node->sub_node_num = Size(node->left.get()) + Size(node->right.get()) + 1;
+		return changed;
+	}
+
+	// ԵΪڽڵʱϲɫͽṹٱ䣬ֻۼӼ
+	// added¹ϵĽڵJoinʱ¹ϵһ
+	// ؽṹܱ仯ϲpathе±꣬ϵָԭĽڵ
+	const int FixUpAfterPut(UniqueNodeType** path, int depth, int added = 1)
+	{
+		int i = depth - 1;
+		for (; i >= 0; --i)
+		{
+			UniqueNodeType& node = *path[i];
+			node->sub_node_num += added;
+
+			// ӽڵǺڵ㣬ӽڵǺڽڵ㣬Ҫת
+			if (IsRed(node->right.get()) && !IsRed(node->left.get()))
+			{
+				node = RotateLeft(std::move(node));
+			}
+
+			// ӽڵǺڵͬʱӽڵӽڵҲǺڵ㣬Ҫת
+			if (IsRed(node->left.get()) && IsRed(node->left->left.get()))
+			{
+				node = RotateRight(std::move(node));
+			}
+
+			// ӽڵӽڵ㶼Ǻڵ㣬Ҫ任ɫ
+			if (IsRed(node->left.get()) && IsRed(node->right.get()))
+			{
+				FlipColor(node.get());
+			}
+			Pull(node.get());
+
+			if (!IsRed(node.get()))
+			{
+				--i;
+				break;
+			}
+		}
+
+		const int changed = i + 1;
+		for (; i >= 0; --i)
+		{
+			(*path[i])->sub_node_num += added;
+			Pull(path[i]->get());
+		}
+
+		return changed;
+	}
+
+	// ݹлҪһ̵ཻ߳Ĳthread_numΪ0ʱȡӲ߳Ϊ1ʱ
+	static const int ParallelDepth(int thread_num)
+	{
+		if (thread_num <= 0)
+		{
+			thread_num = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+		}
+		int parallel_depth = 0;
+		if (thread_num > 1)
+		{
+			while ((1 << parallel_depth) < thread_num)
+			{
+				++parallel_depth;
+			}
+			parallel_depth += kExtraParallelDepth;
+		}
+		return parallel_depth;
+	}
+
+	// nodeΪڵalloc
+	static UniqueNodeType Clone(const NodeType* node, AllocatorType& alloc, int parallel_depth)
+	{
+		if (node == nullptr)
+		{
+			return nullptr;
+		}
+
+		UniqueNodeType copy = alloc.New(node->val);
+		copy->color = node->color;
+		copy->sub_node_num = node->sub_node_num;
+		static_cast<NodeAugment<TAugment>&>(*copy) = static_cast<const NodeAugment<TAugment>&>(*node);
+
+		if (parallel_depth > 0 && node->sub_node_num >= kParallelMinNum)
+		{
+			std::thread worker([&]()
+				{
+					AllocatorType worker_alloc;
+					copy->left = Clone(node->left.get(), worker_alloc, parallel_depth - 1);
+				});
+			copy->right = Clone(node->right.get(), alloc, parallel_depth - 1);
+			worker.join();
+		}
+		else
+		{
+			copy->left = Clone(node->left.get(), alloc, parallel_depth);
+			copy->right = Clone(node->right.get(), alloc, parallel_depth);
+		}
+		return copy;
+	}
+
+	enum class SetOp
+	{
+		kUnion,
+		kIntersection,
+		kDifference,
+	};
+
+	void SetOperation(RedBlackBST& other, int thread_num, SetOp op)
+	{
+		if (&other == this)
+		{
+			if (op == SetOp::kDifference)
+			{
+				Clear();
+			}
+			return;
+		}
+
+		if (alloc_ != other.alloc_ || multiset_ != other.multiset_)
+		{
+			MergeAndRebuild(other, op);
+			return;
+		}
+
+		const int parallel_depth = ParallelDepth(thread_num);
+		std::vector<UniqueNodeType> garbage;
+		root_ = SetOperation(std::move(root_), std::move(other.root_), op, parallel_depth, garbage);
+		if (root_ != nullptr)
+		{
+			root_->color = NodeType::BLACK;
+		}
+
+		for (auto& node : garbage)
+		{
+			alloc_.Free(std::move(node));
+		}
+	}
+
+	// leftrightΪ㣬еĽڵ㶼ҪŽgarbage
+	UniqueNodeType SetOperation(UniqueNodeType left, UniqueNodeType right, SetOp op, int parallel_depth, std::vector<UniqueNodeType>& garbage)
+	{
+		if (left == nullptr || right == nullptr)
+		{
+			if (op == SetOp::kUnion)
+			{
+				return left != nullptr ? std::move(left) : std::move(right);
+			}
+			if (op == SetOp::kDifference && right == nullptr)
+			{
+				return left;
+			}
+
+			// ΪգleftΪգʣµһ඼Ҫ
+			if (left != nullptr)
+			{
+				garbage.push_back(std::move(left));
+			}
+			if (right != nullptr)
+			{
+				garbage.push_back(std::move(right));
+			}
+			return nullptr;
+		}
+
+		const int total = Size(left.get()) + Size(right.get());
+		UniqueNodeType sub_left = std::move(left->left);
+		UniqueNodeType sub_right = std::move(left->right);
+		left->sub_node_num -= Size(sub_left.get()) + Size(sub_right.get());
+
+		UniqueNodeType right_less;
+		UniqueNodeType equal;
+		UniqueNodeType right_greater;
+		int less_height = 0;
+		int greater_height = 0;
+		const int right_height = BlackHeight(right.get());
+		Split(std::move(right), right_height, left->val, right_less, less_height, equal, right_greater, greater_height);
+
+		// ȡ߽ϴģȡСģǶؼʱ1
+		int num = left->sub_node_num;
+		if (equal != nullptr)
+		{
+			const int other_num = equal->sub_node_num;
+			if (op == SetOp::kUnion)
+			{
+				num = std::max(num, other_num);
+			}
+			else if (op == SetOp::kIntersection)
+			{
+				num = std::min(num, other_num);
+			}
+			else
+			{
+				num = std::max(num - other_num, 0);
+			}
+			garbage.push_back(std::move(equal));
+		}
+		else if (op == SetOp::kIntersection)
+		{
+			num = 0;
+		}
+
+		UniqueNodeType less;
+		UniqueNodeType greater;
+		auto solve_less = [&](std::vector<UniqueNodeType>& local_garbage)
+		{
+			less = SetOperation(std::move(sub_left), std::move(right_less), op, parallel_depth - 1, local_garbage);
+		};
+		auto solve_greater = [&](std::vector<UniqueNodeType>& local_garbage)
+		{
+			greater = SetOperation(std::move(sub_right), std::move(right_greater), op, parallel_depth - 1, local_garbage);
+		};
+
+		if (parallel_depth > 0 && total >= kParallelMinNum)
+		{
+			std::vector<UniqueNodeType> worker_garbage;
+			std::thread worker([&]() { solve_less(worker_garbage); });
+			solve_greater(garbage);
+			worker.join();
+			std::move(worker_garbage.begin(), worker_garbage.end(), std::back_inserter(garbage));
+		}
+		else
+		{
+			solve_less(garbage);
+			solve_greater(garbage);
+		}
+
+		// ֻ߶еĸֻotherûеĸ
+		if (num == 0)
+		{
+			garbage.push_back(std::move(left));
+			return Concat(std::move(less), std::move(greater));
+		}
+		left->sub_node_num = num;
+
+		const int less_root_height = BlackHeight(less.get());
+		const int greater_root_height = BlackHeight(greater.get());
+		int height = 0;
+		return Join(std::move(less), less_root_height, std::move(left), std::move(greater), greater_root_height, height);
+	}
+
+	// ƴleftеԪضСrightеԪ
+	UniqueNodeType Concat(UniqueNodeType left, UniqueNodeType right)
+	{
+		if (left == nullptr)
+		{
+			return right;
+		}
+		if (right == nullptr)
+		{
+			return left;
+		}
+
+		UniqueNodeType node = DetachMin(right);
+		const int left_height = BlackHeight(left.get());
+		const int right_height = BlackHeight(right.get());
+		int height = 0;
+		return Join(std::move(left), left_height, std::move(node), std::move(right), right_height, height);
+	}
+
+	// ͬʱȡߵֵ鲢ñķؽ
+	// Ƕؼʱÿֵظ׼򼯺㷨ظԪصĴڵϵĹһ
+	void MergeAndRebuild(RedBlackBST& other, SetOp op)
+	{
+		std::vector<RealTType> vals;
+		auto merge = [this, &vals, op](auto first1, auto last1, auto first2, auto last2)
+		{
+			auto compare = [this](const RealTType& l, const RealTType& r) { return compare_(l, r); };
+			if (op == SetOp::kUnion)
+			{
+				std::set_union(first1, last1, first2, last2, std::back_inserter(vals), compare);
+			}
+			else if (op == SetOp::kIntersection)
+			{
+				std::set_intersection(first1, last1, first2, last2, std::back_inserter(vals), compare);
+			}
+			else
+			{
+				std::set_difference(first1, last1, first2, last2, std::back_inserter(vals), compare);
+			}
+		};
+
+		if (multiset_)
+		{
+			std::vector<RealTType> left_vals;
+			std::vector<RealTType> right_vals;
+			AppendVals(left_vals, true);
+			other.AppendVals(right_vals, true);
+			merge(left_vals.begin(), left_vals.end(), right_vals.begin(), right_vals.end());
+		}
+		else
+		{
+			merge(begin(), end(), other.begin(), other.end());
+		}
+
+		other.Clear();
+		BuildFromSorted(std::make_move_iterator(vals.begin()), std::make_move_iterator(vals.end()));
+	}
+
+	// Ԫ׷ӵvalsУwith_duplicatesΪtrueʱÿֵظ
+	void AppendVals(std::vector<RealTType>& vals, bool with_duplicates)const
+	{
+		for (auto it = begin(); it != end(); ++it)
+		{
+			vals.insert(vals.end(), with_duplicates ? OwnNum(it.Current()) : 1, *it);
+		}
+	}
+
+	// ժrootΪеСڵ㲢أ÷֤ǿգժĸǺڽڵ
+	UniqueNodeType DetachMin(UniqueNodeType& root)
+	{
+		if (!IsRed(root->left.get()) && !IsRed(root->right.get()))
+		{
+			root->color = NodeType::RED;
+		}
+
+		UniqueNodeType* path[kMaxPathLen];
+		int depth = 0;
+		int changed_depth = kMaxPathLen;
+
+		UniqueNodeType* slot = DescendToMin(&root, path, depth, changed_depth);
+		UniqueNodeType node = std::move(*slot);
+
+		FixUpAfterDelete(path, depth, changed_depth, node->sub_node_num);
+
+		if (root != nullptr)
+		{
+			root->color = NodeType::BLACK;
+		}
+
+		return node;
+	}
+
+	// ӸӾĺڽڵڵĺڸߵӵĺڸ
+	const int BlackHeight(NodeType* node)const noexcept
+	{
+		int black = 0;
+		for (; node != nullptr; node = node->left.get())
+		{
+			if (!IsRed(node))
+			{
+				++black;
+			}
+		}
+
+		return black;
+	}
+
+	// ѺڸΪblack_heightkeyпСkeyĲƴleftkeyĲƴrightͬʱߵĺڸߣ
+	// keyĽڵŽequal÷ָ룩
+	// ÿֻѵǰڵһƴ²гĽϣƴӵĺڸ߲֮Ͳ
+	template<typename TKey>
+	void Split(UniqueNodeType node, int black_height, const TKey& key, UniqueNodeType& left, int& left_height,
+		UniqueNodeType& equal, UniqueNodeType& right, int& right_height)
+	{
+		if (node == nullptr)
+		{
+			left = nullptr;
+			right = nullptr;
+			left_height = 0;
+			right_height = 0;
+			return;
+		}
+
+		const int sub_height = IsRed(node.get()) ? black_height : black_height - 1;
+		UniqueNodeType sub_left = std::move(node->left);
+		UniqueNodeType sub_right = std::move(node->right);
+		node->sub_node_num -= Size(sub_left.get()) + Size(sub_right.get());
+
+		UniqueNodeType middle;
+		int middle_height = 0;
+		if (compare_(node->val, key))
+		{
+			Split(std::move(sub_right), sub_height, key, middle, middle_height, equal, right, right_height);
+			left = Join(std::move(sub_left), sub_height, std::move(node), std::move(middle), middle_height, left_height);
+		}
+		else if (compare_(key, node->val))
+		{
+			Split(std::move(sub_left), sub_height, key, left, left_height, equal, middle, middle_height);
+			right = Join(std::move(middle), middle_height, std::move(node), std::move(sub_right), sub_height, right_height);
+		}
+		else
+		{
+			left = std::move(sub_left);
+			left_height = sub_height;
+			right = std::move(sub_right);
+			right_height = sub_height;
+			equal = std::move(node);
+		}
+	}
+
+	// nodeΪָleftrightƴһ÷֤left < node < rightnodeûкӣ
+	// heightؽĺڸߡ
+	// ڸʱnodeֱӽϸߵһؿһı߽½ڸȵĺڽڵ㣬
+	// nodeΪڵǸλòһڵ㣬ٰķʽԵ
+	// ӶO(|left_height - right_height| + 1)
+	UniqueNodeType Join(UniqueNodeType left, int left_height, UniqueNodeType node, UniqueNodeType right, int right_height, int& height)
+	{
+		// ɫĸֱȾڣڸ߼1
+		if (IsRed(left.get()))
+		{
+			left->color = NodeType::BLACK;
+			++left_height;
+		}
+		if (IsRed(right.get()))
+		{
+			right->color = NodeType::BLACK;
+			++right_height;
+		}
+
+		if (left_height == right_height)
+		{
+			node->sub_node_num += Size(left.get()) + Size(right.get());
+			node->left = std::move(left);
+			node->right = std::move(right);
+			node->color = NodeType::BLACK;
+			Pull(node.get());
+			height = left_height + 1;
+			return node;
+		}
+
+		UniqueNodeType* path[kMaxPathLen];
+		int depth = 0;
+		UniqueNodeType root;
+		node->color = NodeType::RED;
+
+		if (left_height > right_height)
+		{
+			// ûкڵ㣬ÿ½һڸ߼1
+			const int added = Size(right.get()) + node->sub_node_num;
+			root = std::move(left);
+			UniqueNodeType* slot = &root;
+			for (int cur_height = left_height; cur_height > right_height; --cur_height)
+			{
+				path[depth++] = slot;
+				slot = &(*slot)->right;
+			}
+
+			node->sub_node_num = Size(slot->get()) + added;
+			node->left = std::move(*slot);
+			node->right = std::move(right);
+			Pull(node.get());
+			*slot = std::move(node);
+
+			FixUpAfterPut(path, depth, added);
+			height = left_height;
+		}
+		else
+		{
+			// ϵĺڵ͸ڵͬһ3-ڵ㣬ıڸ
+			const int added = Size(left.get()) + node->sub_node_num;
+			root = std::move(right);
+			UniqueNodeType* slot = &root;
+			for (int cur_height = right_height; cur_height > left_height; --cur_height)
+			{
+				path[depth++] = slot;
+				slot = &(*slot)->left;
+				if (IsRed(slot->get()))
+				{
+					path[depth++] = slot;
+					slot = &(*slot)->left;
+				}
+			}
+
+			node->sub_node_num = Size(slot->get()) + added;
+			node->right = std::move(*slot);
+			node->left = std::move(left);
+			Pull(node.get());
+			*slot = std::move(node);
+
+			FixUpAfterPut(path, depth, added);
+			height = right_height;
+		}
+
+		if (IsRed(root.get()))
+		{
+			root->color = NodeType::BLACK;
+			++height;
+		}
+
+		return root;
+	}
+
+	// ½Сڵ㣬Сڵڵλ
+	UniqueNodeType* DescendToMin(UniqueNodeType* slot, UniqueNodeType** path, int& depth, int& changed_depth)
+	{
+		while ((*slot)->left != nullptr)
+		{
+			if (!IsRed((*slot)->left.get()) && !IsRed((*slot)->left->left.get()))
+			{
+				*slot = MoveRedLeft(std::move(*slot));
+				changed_depth = std::min(changed_depth, depth);
+			}
+
+			path[depth++] = slot;
+			slot = &(*slot)->left;
+		}
+
+		return slot;
+	}
+
+	// 佨һȫƽؼģʽȵһκϲһڵ㣬black_heightĺڸ
+	template<typename TIterator>
+	UniqueNodeType BuildSorted(TIterator first, TIterator last, int& black_height)
+	{
+		int num = 0;
+		if (multiset_)
+		{
+			for (TIterator it = first; it != last; ++num)
+			{
+				TIterator prev = it;
+				while (++it != last && !compare_(*prev, *it))
+				{
+				}
+			}
+		}
+		else
+		{
+			num = static_cast<int>(std::distance(first, last));
+		}
+
+		black_height = 0;
+		while ((2LL << black_height) - 1 <= num)
+		{
+			++black_height;
+		}
+
+		auto make = [this, &first, &last]()
+		{
+			UniqueNodeType node = alloc_.New(*first);
+			++first;
+			while (multiset_ && first != last && !compare_(node->val, *first))
+			{
+				++node->sub_node_num;
+				++first;
+			}
+			return node;
+		};
+		return Build(make, num, black_height);
+	}
+
+	// [first, last)nodeΪڸΪblack_heightheightؽĺڸߡ
+	// nodeֵгηֱnodeΪָƴӣnodeֵԣؼģʽۼӵϡ
+	// ΪյԭأΪʱֱӽֻаֵ·ϵĽڵᱻƴ
+	template<typename TIterator>
+	UniqueNodeType MergeSorted(UniqueNodeType node, int black_height, TIterator first, TIterator last, int& height)
+	{
+		if (first == last)
+		{
+			height = black_height;
+			return node;
+		}
+		if (node == nullptr)
+		{
+			return BuildSorted(first, last, height);
+		}
+
+		// ֻʣһֵʱƴӲֱӲ룬Ⱦʱڸ߰ڵĹ򲻱䣬ϲJoinȾ
+		if (std::next(first) == last)
+		{
+			UniqueNodeType* path[kMaxPathLen];
+			int depth = 0;
+			UniqueNodeType* slot = FindSlot(*first, &node, path, depth);
+			if (slot == nullptr)
+			{
+				if (multiset_)
+				{
+					for (int i = 0; i < depth; ++i)
+					{
+						++(*path[i])->sub_node_num;
+					}
+				}
+			}
+			else
+			{
+				*slot = alloc_.New(*first);
+				Pull(slot->get());
+				FixUpAfterPut(path, depth);
+			}
+			height = black_height;
+			return node;
+		}
+
+		const int sub_height = IsRed(node.get()) ? black_height : black_height - 1;
+		UniqueNodeType sub_left = std::move(node->left);
+		UniqueNodeType sub_right = std::move(node->right);
+		node->sub_node_num -= Size(sub_left.get()) + Size(sub_right.get());
+
+		TIterator middle = std::lower_bound(first, last, node->val, compare_);
+		TIterator upper = middle;
+		while (upper != last && !compare_(node->val, *upper))
+		{
+			if (multiset_)
+			{
+				++node->sub_node_num;
+			}
+			++upper;
+		}
+
+		int left_height = 0;
+		int right_height = 0;
+		UniqueNodeType left = MergeSorted(std::move(sub_left), sub_height, first, middle, left_height);
+		UniqueNodeType right = MergeSorted(std::move(sub_right), sub_height, upper, last, right_height);
+		return Join(std::move(left), left_height, std::move(node), std::move(right), right_height, height);
+	}
+
+	// makeβnumڵ㽨ȡnumڵСڸߣÿ㰴2-ڵ3-ڵз
+	template<typename TMaker>
+	void BuildRoot(TMaker& make, int num)
+	{
+		int black_height = 0;
+		while ((2LL << black_height) - 1 <= num)
+		{
+			++black_height;
+		}
+
+		root_ = Build(make, num, black_height);
+	}
+
+	// makeĽڵ㹹numڵ㡢ڸΪblack_height
+	// makeĽڵûкӣ
+	// ڸΪh2-3[2^h-1, 3^h-1]ڵ㣬Ųʱ3-ڵ
+	template<typename TMaker>
+	UniqueNodeType Build(TMaker& make, int num, int black_height)
+	{
+		if (num == 0)
+		{
+			return nullptr;
+		}
+
+		long long sub_max = 1;
+		for (int i = 1; i < black_height; ++i)
+		{
+			sub_max *= 3;
+		}
+		sub_max -= 1;
+
+		if (num - 1 <= 2 * sub_max)
+		{
+			int left_num = (num - 1) / 2;
+
+			UniqueNodeType left = Build(make, left_num, black_height - 1);
+			UniqueNodeType node = make();
+			node->left = std::move(left);
+			node->right = Build(make, num - 1 - left_num, black_height - 1);
+			node->sub_node_num += Size(node->left.get()) + Size(node->right.get());
+			node->color = NodeType::BLACK;
+			Pull(node.get());
+
+			return node;
+		}
+
+		int left_num = (num - 2) / 3;
+		int middle_num = (num - 2 - left_num) / 2;
+
+		UniqueNodeType left = Build(make, left_num, black_height - 1);
+		UniqueNodeType red_node = make();
+		red_node->left = std::move(left);
+		red_node->right = Build(make, middle_num, black_height - 1);
+		red_node->sub_node_num += Size(red_node->left.get()) + Size(red_node->right.get());
+		red_node->color = NodeType::RED;
+		Pull(red_node.get());
+
+		UniqueNodeType node = make();
+		node->left = std::move(red_node);
+		node->right = Build(make, num - 2 - left_num - middle_num, black_height - 1);
+		node->sub_node_num += Size(node->left.get()) + Size(node->right.get());
+		node->color = NodeType::BLACK;
+		Pull(node.get());
 
 		return node;
 	}
 
+	// ɹĽڵ㣬ڵҺӱÿգֻʣ
+	void Flatten(UniqueNodeType node, std::vector<UniqueNodeType>& nodes)
+	{
+		std::vector<UniqueNodeType> stack;
+		while (node != nullptr || !stack.empty())
+		{
+			while (node != nullptr)
+			{
+				UniqueNodeType left = std::move(node->left);
+				node->sub_node_num -= Size(left.get());
+				stack.push_back(std::move(node));
+				node = std::move(left);
+			}
+
+			node = std::move(stack.back());
+			stack.pop_back();
+
+			UniqueNodeType right = std::move(node->right);
+			node->sub_node_num -= Size(right.get());
+			nodes.push_back(std::move(node));
+			node = std::move(right);
+		}
+	}
+
+	// ɾԵremovedժµĽڵ
+	// Balanceֻ㣬ûиĶĲ㲻ƽ
+	void FixUpAfterDelete(UniqueNodeType** path, int depth, int changed_depth, int removed)
+	{
+		changed_depth = std::min(changed_depth, depth);
+
+		for (int i = depth - 1; i >= 0; --i)
+		{
+			UniqueNodeType& node = *path[i];
+			node->sub_node_num -= removed;
+
+			if (i + 2 >= changed_depth && Balance(node))
+			{
+				changed_depth = std::min(changed_depth, i);
+			}
+			Pull(node.get());
+		}
+	}
+
 	UniqueNodeType MoveRedLeft(UniqueNodeType node)
 	{
 		if (node == nullptr)
@@ -836,6 +2638,7 @@ private:
 			return node;
 		}
 
+		TREE_STATS_INC(move_red_left);
 		FlipColor(node.get());
 		if (node->right != nullptr && IsRed(node->right->left.get()))
 		{
@@ -862,6 +2665,7 @@ private:
 			return node;
 		}
 
+		TREE_STATS_INC(move_red_right);
 		FlipColor(node.get());
 		if (node->left != nullptr && IsRed(node->left->left.get()))
 		{
@@ -874,13 +2678,23 @@ private:
 	
 
 private:
+	// ɾʱ¼·󳤶ȣ㹻intΧڽڵ
+	static const int kMaxPathLen = 128;
+	// ͸ôڵŽ߳
+	static const int kParallelMinNum = 1 << 14;
+	// ڸthread_num߳Ĳ֮ಢеĲ
+	static const int kExtraParallelDepth = 2;
+
+	TCompare compare_;
+	AllocatorType alloc_;
 	UniqueNodeType root_;
+	bool multiset_ = false;
 };
 
-template<>
-class RedBlackBST<float> {};
+template<template<typename> class TAllocator, typename TCompare, typename TAugment>
+class RedBlackBST<float, TAllocator, TCompare, TAugment> {};
 
-template<>
-class RedBlackBST<double> {};
+template<template<typename> class TAllocator, typename TCompare, typename TAugment>
+class RedBlackBST<double, TAllocator, TCompare, TAugment> {};
 
 #endif // !TREE_H_
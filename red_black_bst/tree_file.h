@@ -0,0 +1,554 @@
+#ifndef TREE_FILE_H_
+#define TREE_FILE_H_
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <functional>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// ݵĶļʽڽʱٻָ
+//   ļͷ TreeFileHeader֮data_offsetʼǰеnumTreeFileRecord<T>
+// ԪرǿƽƵͣļûָ룬ţ±
+// ļֱmmapѯMappedTreeҲBuildFromSortedO(N)ؽɿ޸ĵ
+// ؼģʽظдÿֵflagsбǣļֻ뵽ͬ˶ؼģʽ
+struct TreeFileHeader
+{
+	static const uint32_t kVersion = 3;
+	static const uint32_t kEndianTag = 0x01020304;
+	static const uint64_t kDataAlign = 64;
+	// ȵֵֶ
+	static const uint32_t kFlagMultiset = 1;
+
+	char magic[8];
+	uint32_t version;
+	uint32_t endian_tag;
+	uint32_t val_size;
+	uint32_t val_align;
+	uint64_t num;
+	uint64_t data_offset;
+	uint32_t flags;
+	uint32_t reserved;
+	// дļһĴJournaledTreeж־Щ¼Ѿļ
+	uint64_t generation;
+};
+
+inline const char* TreeFileMagic()noexcept
+{
+	return "TREEFILE";
+}
+
+template<typename T>
+struct TreeFileRecord
+{
+	T val;
+};
+
+// ѻļд
+inline bool SyncTreeFile(std::FILE* file)
+{
+	if (std::fflush(file) != 0)
+	{
+		return false;
+	}
+#if defined(_WIN32)
+	return _commit(_fileno(file)) == 0;
+#else
+	return fsync(fileno(file)) == 0;
+#endif
+}
+
+// дõʱļԭӵ滻pathsyncΪtrueʱȸҲ
+inline bool ReplaceTreeFile(const char* tmp_path, const char* path, bool sync)
+{
+#if defined(_WIN32)
+	const DWORD flags = MOVEFILE_REPLACE_EXISTING | (sync ? MOVEFILE_WRITE_THROUGH : 0);
+	return MoveFileExA(tmp_path, path, flags) != 0;
+#else
+	if (std::rename(tmp_path, path) != 0)
+	{
+		return false;
+	}
+	if (!sync)
+	{
+		return true;
+	}
+
+	// ¼Ŀ¼Ŀ¼ҲҪfsync
+	const char* slash = std::strrchr(path, '/');
+	const std::string dir = slash == nullptr ? std::string(".") : (slash == path ? std::string("/") : std::string(path, slash - path));
+	int fd = open(dir.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	const bool ok = fsync(fd) == 0;
+	close(fd);
+	return ok;
+#endif
+}
+
+// дļдʱļٸfalseʱԭеļ䣻
+// syncΪtrueʱǰfsyncʱļfsyncĿ¼true֮Ҳܶļ
+// syncΪfalseʱֻ֤̱дһļܶļļ
+// generationԭдļͷMappedTree::Generation()
+template<typename TTree>
+bool SaveTreeFile(const TTree& tree, const char* path, bool sync = true, uint64_t generation = 0)
+{
+	using RealTType = typename TTree::RealTType;
+	using NodeType = typename TTree::NodeType;
+	static_assert(std::is_trivially_copyable<RealTType>::value, "tree file needs trivially copyable values");
+
+	const std::string tmp_path = std::string(path) + ".tmp";
+	std::FILE* file = std::fopen(tmp_path.c_str(), "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	TreeFileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, TreeFileMagic(), sizeof(header.magic));
+	header.version = TreeFileHeader::kVersion;
+	header.endian_tag = TreeFileHeader::kEndianTag;
+	header.val_size = sizeof(RealTType);
+	header.val_align = alignof(RealTType);
+	header.num = static_cast<uint64_t>(tree.Size());
+	header.flags = tree.IsMultiset() ? TreeFileHeader::kFlagMultiset : 0;
+	header.generation = generation;
+	header.data_offset = (sizeof(TreeFileHeader) + TreeFileHeader::kDataAlign - 1) / TreeFileHeader::kDataAlign * TreeFileHeader::kDataAlign;
+
+	std::vector<char> padding(static_cast<size_t>(header.data_offset - sizeof(TreeFileHeader)), 0);
+	bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	ok = ok && (padding.empty() || std::fwrite(padding.data(), padding.size(), 1, file) == 1);
+
+	// ǵݹ˻ĶҲջһд
+	const size_t kBatchNum = 4096;
+	std::vector<TreeFileRecord<RealTType>> records;
+	records.reserve(kBatchNum);
+	std::vector<const NodeType*> stack;
+
+	const NodeType* node = tree.GetRoot();
+	while (ok && (node != nullptr || !stack.empty()))
+	{
+		while (node != nullptr)
+		{
+			stack.push_back(node);
+			node = node->left.get();
+		}
+
+		node = stack.back();
+		stack.pop_back();
+
+		// ؼģʽ°ظдǼвĲ
+		int num = node->sub_node_num;
+		num -= node->left != nullptr ? node->left->sub_node_num : 0;
+		num -= node->right != nullptr ? node->right->sub_node_num : 0;
+		for (; ok && num > 0; --num)
+		{
+			records.push_back(TreeFileRecord<RealTType>{ node->val });
+			if (records.size() == kBatchNum)
+			{
+				ok = std::fwrite(records.data(), sizeof(TreeFileRecord<RealTType>), records.size(), file) == records.size();
+				records.clear();
+			}
+		}
+
+		node = node->right.get();
+	}
+	if (ok && !records.empty())
+	{
+		ok = std::fwrite(records.data(), sizeof(TreeFileRecord<RealTType>), records.size(), file) == records.size();
+	}
+
+	ok = ok && (!sync || SyncTreeFile(file));
+	ok = (std::fclose(file) == 0) && ok;
+	if (!ok)
+	{
+		std::remove(tmp_path.c_str());
+		return false;
+	}
+
+	return ReplaceTreeFile(tmp_path.c_str(), path, sync);
+}
+
+// ֻӳļ򿪺󼴿ɲѯѯӿRedBlackBSTһ
+template<typename T, typename TCompare = std::less<std::remove_reference_t<std::decay_t<T>>>>
+class MappedTree
+{
+public:
+	using RealTType = std::remove_reference_t<std::decay_t<T>>;
+	using NodeType = TreeFileRecord<RealTType>;
+	static_assert(std::is_trivially_copyable<RealTType>::value, "tree file needs trivially copyable values");
+	static_assert(sizeof(NodeType) == sizeof(RealTType), "record must have the same layout as the value");
+
+	explicit MappedTree(const TCompare& compare = TCompare()) :compare_(compare)
+	{
+	}
+
+	~MappedTree()
+	{
+		Close();
+	}
+
+	MappedTree(const MappedTree&) = delete;
+	MappedTree& operator=(const MappedTree&) = delete;
+
+	MappedTree(MappedTree&&) = delete;
+	MappedTree& operator=(MappedTree&&) = delete;
+
+public:
+	// ӳļУļͷʽ汾ֽԪشСʱfalse
+	bool Open(const char* path)
+	{
+		Close();
+
+		if (!Map(path))
+		{
+			return false;
+		}
+
+		TreeFileHeader header;
+		if (size_ < sizeof(header))
+		{
+			Close();
+			return false;
+		}
+		std::memcpy(&header, base_, sizeof(header));
+
+		if (std::memcmp(header.magic, TreeFileMagic(), sizeof(header.magic)) != 0 ||
+			header.version != TreeFileHeader::kVersion ||
+			header.endian_tag != TreeFileHeader::kEndianTag ||
+			header.val_size != sizeof(RealTType) ||
+			header.val_align != alignof(RealTType) ||
+			header.data_offset % alignof(NodeType) != 0 ||
+			header.data_offset > size_ ||
+			header.num > (size_ - header.data_offset) / sizeof(NodeType) ||
+			(header.flags & ~TreeFileHeader::kFlagMultiset) != 0)
+		{
+			Close();
+			return false;
+		}
+
+		records_ = reinterpret_cast<const NodeType*>(static_cast<const char*>(base_) + header.data_offset);
+		num_ = static_cast<int>(header.num);
+		multiset_ = (header.flags & TreeFileHeader::kFlagMultiset) != 0;
+		generation_ = header.generation;
+
+		return true;
+	}
+
+	void Close()noexcept
+	{
+		Unmap();
+		records_ = nullptr;
+		num_ = 0;
+		multiset_ = false;
+		generation_ = 0;
+	}
+
+	// ļԶؼģʽȵֵֶ
+	const bool IsMultiset()const noexcept
+	{
+		return multiset_;
+	}
+
+	// ʱĴ
+	const uint64_t Generation()const noexcept
+	{
+		return generation_;
+	}
+
+	template<typename NodeValType>
+	NodeType const*const Get(const NodeValType& val)const noexcept
+	{
+		const int index = CountLess(val);
+		if (index < num_ && IsEqual(val, records_[index].val))
+		{
+			return &records_[index];
+		}
+
+		return nullptr;
+	}
+
+	template<typename NodeValType>
+	const bool IsExists(const NodeValType& val)const noexcept
+	{
+		return Get(val) != nullptr;
+	}
+
+	// 1ʼvalʱ0
+	template<typename NodeValType>
+	const int Rank(const NodeValType& val)const noexcept
+	{
+		const int index = CountLess(val);
+		if (index < num_ && !compare_(val, records_[index].val))
+		{
+			return index + 1;
+		}
+
+		return 0;
+	}
+
+	NodeType const*const Select(int ranking)const noexcept
+	{
+		if (ranking < 1 || ranking > num_)
+		{
+			return nullptr;
+		}
+
+		return &records_[ranking - 1];
+	}
+
+	template<typename NodeValType>
+	const int CountLess(const NodeValType& val)const noexcept
+	{
+		return Partition([this, &val](const RealTType& key) { return compare_(key, val); });
+	}
+
+	// RedBlackBST::Floorһ£ȡϸСvalԪ
+	template<typename NodeValType>
+	NodeType const*const Floor(const NodeValType& val)const noexcept
+	{
+		const int index = Partition([this, &val](const RealTType& key) { return !LessEqual(val, key); });
+
+		return index > 0 ? &records_[index - 1] : nullptr;
+	}
+
+	// RedBlackBST::Ceilingһ£ȡϸvalСԪ
+	template<typename NodeValType>
+	NodeType const*const Ceiling(const NodeValType& val)const noexcept
+	{
+		const int index = Partition([this, &val](const RealTType& key) { return LessEqual(key, val); });
+
+		return index < num_ ? &records_[index] : nullptr;
+	}
+
+	NodeType const*const Min()const noexcept
+	{
+		return Select(1);
+	}
+
+	NodeType const*const Max()const noexcept
+	{
+		return Select(num_);
+	}
+
+	// ȫԪأֱӴBuildFromSorted
+	const RealTType* begin()const noexcept
+	{
+		return records_ == nullptr ? nullptr : &records_[0].val;
+	}
+
+	const RealTType* end()const noexcept
+	{
+		return records_ == nullptr ? nullptr : &records_[0].val + num_;
+	}
+
+	const bool IsEmpty()const noexcept
+	{
+		return num_ == 0;
+	}
+
+	const int Size()const noexcept
+	{
+		return num_;
+	}
+
+private:
+	// һʹlessΪfalse±꣬lesstruefalse
+	template<typename TLess>
+	int Partition(TLess&& less)const noexcept
+	{
+		int low = 0;
+		int num = num_;
+		while (num > 0)
+		{
+			int half = num / 2;
+			if (less(records_[low + half].val))
+			{
+				low += half + 1;
+				num -= half + 1;
+			}
+			else
+			{
+				num = half;
+			}
+		}
+
+		return low;
+	}
+
+	// ͬ͵ֵTԼ==RedBlackBSTһ
+	const bool IsEqual(const RealTType& key, const RealTType& val)const noexcept
+	{
+		return key == val;
+	}
+
+	template<typename TKey>
+	const bool IsEqual(const TKey& key, const RealTType& val)const noexcept
+	{
+		return !compare_(key, val) && !compare_(val, key);
+	}
+
+	// ĬϱȽͬ͵ֵTԼ<=ɱȽƳ
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right)const noexcept
+	{
+		return LessEqual(left, right, std::integral_constant<bool,
+			std::is_same<TCompare, std::less<RealTType>>::value && std::is_same<TLeft, RealTType>::value && std::is_same<TRight, RealTType>::value>());
+	}
+
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::true_type)const noexcept
+	{
+		return left <= right;
+	}
+
+	template<typename TLeft, typename TRight>
+	const bool LessEqual(const TLeft& left, const TRight& right, std::false_type)const noexcept
+	{
+		return !compare_(right, left);
+	}
+
+#if defined(_WIN32)
+	bool Map(const char* path)
+	{
+		file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file_ == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0)
+		{
+			Unmap();
+			return false;
+		}
+		size_ = static_cast<size_t>(file_size.QuadPart);
+
+		mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping_ == nullptr)
+		{
+			Unmap();
+			return false;
+		}
+
+		base_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+		if (base_ == nullptr)
+		{
+			Unmap();
+			return false;
+		}
+
+		return true;
+	}
+
+	void Unmap()noexcept
+	{
+		if (base_ != nullptr)
+		{
+			UnmapViewOfFile(base_);
+		}
+		if (mapping_ != nullptr)
+		{
+			CloseHandle(mapping_);
+		}
+		if (file_ != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file_);
+		}
+		base_ = nullptr;
+		mapping_ = nullptr;
+		file_ = INVALID_HANDLE_VALUE;
+		size_ = 0;
+	}
+#else
+	bool Map(const char* path)
+	{
+		int fd = open(path, O_RDONLY);
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+		{
+			close(fd);
+			return false;
+		}
+		size_ = static_cast<size_t>(file_stat.st_size);
+
+		// ӳ佨ļͿԹر
+		void* base = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (base == MAP_FAILED)
+		{
+			size_ = 0;
+			return false;
+		}
+		base_ = base;
+
+		return true;
+	}
+
+	void Unmap()noexcept
+	{
+		if (base_ != nullptr)
+		{
+			munmap(base_, size_);
+		}
+		base_ = nullptr;
+		size_ = 0;
+	}
+#endif
+
+private:
+	TCompare compare_;
+	const NodeType* records_ = nullptr;
+	int num_ = 0;
+	bool multiset_ = false;
+	uint64_t generation_ = 0;
+
+	void* base_ = nullptr;
+	size_t size_ = 0;
+#if defined(_WIN32)
+	HANDLE file_ = INVALID_HANDLE_VALUE;
+	HANDLE mapping_ = nullptr;
+#endif
+};
+
+// ļؽ޸ĵO(N)ؼļδؼģʽʱfalse
+template<typename TTree>
+bool LoadTreeFile(TTree& tree, const char* path)
+{
+	MappedTree<typename TTree::RealTType> file;
+	if (!file.Open(path) || (file.IsMultiset() && !tree.IsMultiset()))
+	{
+		return false;
+	}
+
+	tree.BuildFromSorted(file.begin(), file.end());
+
+	return true;
+}
+
+#endif // !TREE_FILE_H_
@@ -0,0 +1,203 @@
+#ifndef TREE_ITERATOR_H_
+#define TREE_ITERATOR_H_
+
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// ˫ڵûиָ룬Լ¼Ӹǰڵ·
+// ·Ϊձʾend()ṹ仯ʧЧ
+template<typename TNode>
+class TreeIterator
+{
+public:
+	using ValueType = std::remove_reference_t<decltype(std::declval<TNode&>().val)>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = ValueType;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const ValueType*;
+	using reference = const ValueType&;
+
+	// ĸ߶Ȳ2*log(N+1)intΧڵĽڵ64㹻
+	static const int kMaxHeight = 64;
+
+	TreeIterator() :root_(nullptr), depth_(0)
+	{
+	}
+
+	explicit TreeIterator(const TNode* root) :root_(root), depth_(0)
+	{
+	}
+
+	// ֻ·ЧĲֵ֣ݺΪʾֵʱؿ
+	TreeIterator(const TreeIterator& other)noexcept :root_(other.root_), depth_(other.depth_)
+	{
+		std::copy(other.path_, other.path_ + other.depth_, path_);
+	}
+
+	TreeIterator& operator=(const TreeIterator& other)noexcept
+	{
+		root_ = other.root_;
+		depth_ = other.depth_;
+		std::copy(other.path_, other.path_ + other.depth_, path_);
+		return *this;
+	}
+
+	reference operator*()const noexcept
+	{
+		return path_[depth_ - 1]->val;
+	}
+
+	pointer operator->()const noexcept
+	{
+		return &path_[depth_ - 1]->val;
+	}
+
+	TreeIterator& operator++()noexcept
+	{
+		const TNode* node = path_[depth_ - 1];
+		if (node->right != nullptr)
+		{
+			Push(node->right.get());
+			PushLeftSpine();
+			return *this;
+		}
+
+		// ݵһ
+		const TNode* child = path_[--depth_];
+		while (depth_ > 0 && path_[depth_ - 1]->right.get() == child)
+		{
+			child = path_[--depth_];
+		}
+
+		return *this;
+	}
+
+	TreeIterator operator++(int)noexcept
+	{
+		TreeIterator tmp = *this;
+		++(*this);
+		return tmp;
+	}
+
+	TreeIterator& operator--()noexcept
+	{
+		if (depth_ == 0)
+		{
+			if (root_ != nullptr)
+			{
+				Push(root_);
+				PushRightSpine();
+			}
+			return *this;
+		}
+
+		const TNode* node = path_[depth_ - 1];
+		if (node->left != nullptr)
+		{
+			Push(node->left.get());
+			PushRightSpine();
+			return *this;
+		}
+
+		const TNode* child = path_[--depth_];
+		while (depth_ > 0 && path_[depth_ - 1]->left.get() == child)
+		{
+			child = path_[--depth_];
+		}
+
+		return *this;
+	}
+
+	TreeIterator operator--(int)noexcept
+	{
+		TreeIterator tmp = *this;
+		--(*this);
+		return tmp;
+	}
+
+	bool operator==(const TreeIterator& other)const noexcept
+	{
+		return Current() == other.Current();
+	}
+
+	bool operator!=(const TreeIterator& other)const noexcept
+	{
+		return Current() != other.Current();
+	}
+
+	// ǰڵ㣬end()ʱΪnullptr
+	const TNode* Current()const noexcept
+	{
+		return depth_ == 0 ? nullptr : path_[depth_ - 1];
+	}
+
+	const int Depth()const noexcept
+	{
+		return depth_;
+	}
+
+	const TNode* NodeAt(int depth)const noexcept
+	{
+		return path_[depth];
+	}
+
+	void Push(const TNode* node)noexcept
+	{
+		path_[depth_++] = node;
+	}
+
+	// ضϵָȣڲʱӸѡڵһ·
+	void Truncate(int depth)noexcept
+	{
+		depth_ = depth;
+	}
+
+	void PushLeftSpine()noexcept
+	{
+		const TNode* node = path_[depth_ - 1];
+		while (node->left != nullptr)
+		{
+			node = node->left.get();
+			path_[depth_++] = node;
+		}
+	}
+
+	void PushRightSpine()noexcept
+	{
+		const TNode* node = path_[depth_ - 1];
+		while (node->right != nullptr)
+		{
+			node = node->right.get();
+			path_[depth_++] = node;
+		}
+	}
+
+private:
+	const TNode* root_;
+	const TNode* path_[kMaxHeight];
+	int depth_;
+};
+
+// һԵɵ䣬ֱڷΧfor
+template<typename TIterator>
+struct IteratorRange
+{
+	TIterator first;
+	TIterator last;
+
+	TIterator begin()const
+	{
+		return first;
+	}
+
+	TIterator end()const
+	{
+		return last;
+	}
+};
+
+#endif // !TREE_ITERATOR_H_
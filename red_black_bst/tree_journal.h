@@ -0,0 +1,613 @@
+#ifndef TREE_JOURNAL_H_
+#define TREE_JOURNAL_H_
+
+#include "tree_file.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ־
+struct JournalOptions
+{
+	// ܹgroup_num¼ͻѺ̨߳дһļύ
+	int group_num = 1024;
+	// group_numʱflush_interval_msҲдһ
+	int flush_interval_ms = 10;
+	// ÿдļǷfsyncرʱֻ֤̱ܶʧд
+	bool sync = true;
+	// ɵļ¼飩̸̨߳ϡдʱ޸ĲŻȴ
+	int buffer_num = 64 * 1024;
+};
+
+// ־ļļͷ֮Ƕļ¼ÿ¼УָͣʱУʧܵļ¼ֹͣ
+// generationЩ¼ڵļĴ
+struct JournalHeader
+{
+	static const uint32_t kVersion = 2;
+
+	char magic[8];
+	uint32_t version;
+	uint32_t val_size;
+	uint64_t generation;
+};
+
+enum class JournalOp : uint32_t
+{
+	kPut = 1,
+	kDelete = 2,
+	kUpdateKey = 3,
+};
+
+template<typename T>
+struct JournalRecord
+{
+	uint32_t op;
+	uint32_t checksum;
+	T val;
+	// ֻUpdateKeyõֵ
+	T new_val;
+};
+
+// ־޸õڴе׷ӵ־ɺ̨̳߳У͡дļfsync
+// ǵߵĻ飬޸·ֻһ¼ԭӼÿһżһѺ̨̣߳
+// ҪȷʱSync()ȴ
+// ָʱļO(N)ؽط־PutϲһPutBatch
+// ޸ĺͲѯҪͬһ߳нС
+// Checkpointѵǰдɴ1ļ־־ͷмµĴ
+// طŲݵȵģUpdateKeyѴڵֵʧܣԻָʱֻطŴļͬ־
+// ֮ʱ־ĴϾɣеļ¼ѰļУֱӶ
+template<typename TTree>
+class JournaledTree
+{
+public:
+	using TreeType = TTree;
+	using RealTType = typename TTree::RealTType;
+	using RecordType = JournalRecord<RealTType>;
+	static_assert(std::is_trivially_copyable<RealTType>::value, "journal needs trivially copyable values");
+
+	explicit JournaledTree(const JournalOptions& options = JournalOptions()) :options_(options)
+	{
+		options_.group_num = options_.group_num < 1 ? 1 : options_.group_num;
+		options_.flush_interval_ms = options_.flush_interval_ms < 1 ? 1 : options_.flush_interval_ms;
+		options_.buffer_num = options_.buffer_num < options_.group_num * 2 ? options_.group_num * 2 : options_.buffer_num;
+	}
+
+	~JournaledTree()
+	{
+		Close();
+	}
+
+	JournaledTree(const JournaledTree&) = delete;
+	JournaledTree& operator=(const JournaledTree&) = delete;
+
+	JournaledTree(JournaledTree&&) = delete;
+	JournaledTree& operator=(JournaledTree&&) = delete;
+
+public:
+	// ļ־ָ֮޸׷ӵjournal_path
+	// ļʱӿʼļڵУ鲻ͨʱfalseⶪCheckpoint
+	bool Open(const char* snapshot_path, const char* journal_path)
+	{
+		Close();
+
+		snapshot_path_ = snapshot_path;
+		journal_path_ = journal_path;
+		replayed_num_ = 0;
+
+		tree_.Clear();
+		generation_ = 0;
+		MappedTree<RealTType> snapshot;
+		if (snapshot.Open(snapshot_path))
+		{
+			// ־еǶؼܴӶؼļָ
+			if (snapshot.IsMultiset() && !tree_.IsMultiset())
+			{
+				return false;
+			}
+			tree_.BuildFromSorted(snapshot.begin(), snapshot.end());
+			generation_ = snapshot.Generation();
+		}
+		else if (IsFileExists(snapshot_path))
+		{
+			return false;
+		}
+
+		long long valid_size = 0;
+		if (!Replay(valid_size))
+		{
+			return false;
+		}
+
+		if (!OpenForAppend(valid_size))
+		{
+			return false;
+		}
+
+		ring_.assign(options_.buffer_num, RecordType());
+		appended_num_ = 0;
+		flushed_num_ = 0;
+		durable_num_ = 0;
+		stop_ = false;
+		sync_requested_ = false;
+		failed_ = false;
+		flusher_ = std::thread([this]() { FlushLoop(); });
+
+		return true;
+	}
+
+	// д껺еļ¼ر־
+	void Close()
+	{
+		if (fd_ < 0)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		flush_cv_.notify_one();
+		flusher_.join();
+
+		CloseFile(fd_);
+		fd_ = -1;
+	}
+
+	void Put(const RealTType& val)
+	{
+		tree_.Put(val);
+		Append(JournalOp::kPut, val, nullptr);
+	}
+
+	void Delete(const RealTType& val)
+	{
+		tree_.Delete(val);
+		Append(JournalOp::kDelete, val, nullptr);
+	}
+
+	// ֻ¼ɹ޸
+	const bool UpdateKey(const RealTType& old_val, const RealTType& new_val)
+	{
+		if (!tree_.UpdateKey(old_val, new_val))
+		{
+			return false;
+		}
+
+		Append(JournalOp::kUpdateKey, old_val, &new_val);
+		return true;
+	}
+
+	// ȴǰ޸ȫдļfsyncдļʧܹʱfalse
+	bool Sync()
+	{
+		if (fd_ < 0)
+		{
+			return false;
+		}
+
+		// ֻ޸ڵ̻߳appended_num_
+		const uint64_t target = appended_num_.load(std::memory_order_relaxed);
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (durable_num_ < target)
+		{
+			sync_requested_ = true;
+			flush_cv_.notify_one();
+		}
+		durable_cv_.wait(lock, [this, target]() { return durable_num_ >= target || failed_; });
+
+		return !failed_;
+	}
+
+	// ѵǰдļɹ־
+	// ־ʧʱ֮ļ¼ھɴ־棬ָʱԱΪдļʧܣSync󷵻false
+	bool Checkpoint()
+	{
+		if (!Sync())
+		{
+			return false;
+		}
+		if (!SaveTreeFile(tree_, snapshot_path_.c_str(), options_.sync, generation_ + 1))
+		{
+			return false;
+		}
+		++generation_;
+
+		// ޸ֻڵǰ̷߳Sync֮󻺳Ϊգ̨̲߳дļ
+		bool ok = false;
+		{
+			std::lock_guard<std::mutex> io_lock(io_mutex_);
+			ok = WriteHeader();
+		}
+		if (!ok)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			failed_ = true;
+		}
+
+		return ok;
+	}
+
+	const TTree& GetTree()const noexcept
+	{
+		return tree_;
+	}
+
+	// һOpenطŵļ¼
+	const int ReplayedNum()const noexcept
+	{
+		return replayed_num_;
+	}
+
+private:
+	void Append(JournalOp op, const RealTType& val, const RealTType* new_val)
+	{
+		if (fd_ < 0)
+		{
+			return;
+		}
+
+		const uint64_t num = appended_num_.load(std::memory_order_relaxed);
+		const uint64_t capacity = ring_.size();
+		if (num - flushed_num_.load(std::memory_order_acquire) == capacity)
+		{
+			// дȺ̨߳ڳλ
+			std::unique_lock<std::mutex> lock(mutex_);
+			sync_requested_ = true;
+			flush_cv_.notify_one();
+			durable_cv_.wait(lock, [this, num, capacity]() { return num - flushed_num_.load(std::memory_order_acquire) < capacity; });
+		}
+
+		// 㣬ṹеֽҲУ飻Уɺ̨߳дļǰ
+		RecordType& record = ring_[num % capacity];
+		std::memset(&record, 0, sizeof(record));
+		record.op = static_cast<uint32_t>(op);
+		std::memcpy(&record.val, &val, sizeof(RealTType));
+		if (new_val != nullptr)
+		{
+			std::memcpy(&record.new_val, new_val, sizeof(RealTType));
+		}
+		appended_num_.store(num + 1, std::memory_order_release);
+
+		if ((num + 1) % options_.group_num == 0)
+		{
+			// ̨֪̼ͨ߳ûȴʱ
+			std::lock_guard<std::mutex> lock(mutex_);
+			flush_cv_.notify_one();
+		}
+	}
+
+	// ̨̣ܹ߳һ顢ʱڡSyncдCloseʱ׷ӵļ¼Удļ
+	void FlushLoop()
+	{
+		const uint64_t capacity = ring_.size();
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (true)
+		{
+			flush_cv_.wait_for(lock, std::chrono::milliseconds(options_.flush_interval_ms), [this]()
+			{
+				return stop_ || sync_requested_ ||
+					appended_num_.load(std::memory_order_acquire) - flushed_num_.load(std::memory_order_relaxed) >= static_cast<uint64_t>(options_.group_num);
+			});
+			sync_requested_ = false;
+
+			const uint64_t begin = flushed_num_.load(std::memory_order_relaxed);
+			const uint64_t target = appended_num_.load(std::memory_order_acquire);
+			if (begin == target)
+			{
+				if (stop_)
+				{
+					return;
+				}
+				continue;
+			}
+			lock.unlock();
+
+			// [begin, target)֮ļ¼flushed_num_ǰ֮ǰᱻ޸̸߳ǣʱд
+			bool ok = true;
+			{
+				std::lock_guard<std::mutex> io_lock(io_mutex_);
+				for (uint64_t i = begin; ok && i < target;)
+				{
+					const size_t first = static_cast<size_t>(i % capacity);
+					const size_t count = static_cast<size_t>(std::min<uint64_t>(target - i, capacity - first));
+					for (size_t j = first; j < first + count; j++)
+					{
+						ring_[j].checksum = Checksum(ring_[j]);
+					}
+					ok = WriteAll(fd_, &ring_[first], count * sizeof(RecordType));
+					i += count;
+				}
+				ok = ok && (!options_.sync || SyncFile(fd_));
+			}
+
+			lock.lock();
+			flushed_num_.store(target, std::memory_order_release);
+			durable_num_ = target;
+			failed_ = failed_ || !ok;
+			durable_cv_.notify_all();
+		}
+	}
+
+	// ־еЧ¼طţvalid_sizeһЧ¼֮λ
+	bool Replay(long long& valid_size)
+	{
+		valid_size = 0;
+
+		std::FILE* file = std::fopen(journal_path_.c_str(), "rb");
+		if (file == nullptr)
+		{
+			return true;
+		}
+
+		JournalHeader header;
+		if (std::fread(&header, sizeof(header), 1, file) != 1)
+		{
+			// ֻдһļͷ־
+			std::fclose(file);
+			return true;
+		}
+		if (std::memcmp(header.magic, JournalMagic(), sizeof(header.magic)) != 0 ||
+			header.version != JournalHeader::kVersion || header.val_size != sizeof(RealTType))
+		{
+			std::fclose(file);
+			return false;
+		}
+		if (header.generation < generation_)
+		{
+			// Checkpointдļûü־¼Ѱļ
+			std::fclose(file);
+			return true;
+		}
+		if (header.generation > generation_)
+		{
+			// ־ڸµļǰļȱCheckpoint
+			std::fclose(file);
+			return false;
+		}
+		valid_size = sizeof(header);
+
+		std::vector<RealTType> puts;
+		RecordType record;
+		while (std::fread(&record, sizeof(record), 1, file) == 1 && record.checksum == Checksum(record))
+		{
+			if (record.op == static_cast<uint32_t>(JournalOp::kPut))
+			{
+				puts.push_back(record.val);
+			}
+			else
+			{
+				FlushPuts(puts);
+				if (record.op == static_cast<uint32_t>(JournalOp::kDelete))
+				{
+					tree_.Delete(record.val);
+				}
+				else if (record.op == static_cast<uint32_t>(JournalOp::kUpdateKey))
+				{
+					tree_.UpdateKey(record.val, record.new_val);
+				}
+			}
+
+			valid_size += sizeof(record);
+			++replayed_num_;
+		}
+		FlushPuts(puts);
+
+		std::fclose(file);
+		return true;
+	}
+
+	void FlushPuts(std::vector<RealTType>& puts)
+	{
+		if (!puts.empty())
+		{
+			tree_.PutBatch(puts.begin(), puts.end());
+			puts.clear();
+		}
+	}
+
+	// صĩβļ¼׷ӷʽ򿪣ļдļͷ
+	bool OpenForAppend(long long valid_size)
+	{
+		fd_ = OpenFile(journal_path_.c_str());
+		if (fd_ < 0)
+		{
+			return false;
+		}
+
+		if (valid_size == 0)
+		{
+			if (!WriteHeader())
+			{
+				CloseFile(fd_);
+				fd_ = -1;
+				return false;
+			}
+			return true;
+		}
+
+		if (!TruncateFile(fd_, valid_size))
+		{
+			CloseFile(fd_);
+			fd_ = -1;
+			return false;
+		}
+
+		return true;
+	}
+
+	// ־д뵱ǰļͷ
+	bool WriteHeader()
+	{
+		JournalHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, JournalMagic(), sizeof(header.magic));
+		header.version = JournalHeader::kVersion;
+		header.val_size = sizeof(RealTType);
+		header.generation = generation_;
+
+		return TruncateFile(fd_, 0) && WriteAll(fd_, &header, sizeof(header)) && (!options_.sync || SyncFile(fd_));
+	}
+
+	// 򲻿ΪļڣûȨޣʱҲ
+	static bool IsFileExists(const char* path)
+	{
+		std::FILE* file = std::fopen(path, "rb");
+		if (file == nullptr)
+		{
+			return errno != ENOENT;
+		}
+		std::fclose(file);
+		return true;
+	}
+
+	static const char* JournalMagic()noexcept
+	{
+		return "TREEJRNL";
+	}
+
+	// FNV-1aǳУֶ¼
+	static uint32_t Checksum(const RecordType& record)noexcept
+	{
+		const size_t checksum_begin = offsetof(RecordType, checksum);
+		const size_t checksum_end = checksum_begin + sizeof(record.checksum);
+
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < sizeof(record); i++)
+		{
+			hash ^= (i >= checksum_begin && i < checksum_end) ? 0 : bytes[i];
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+
+#if defined(_WIN32)
+	static int OpenFile(const char* path)
+	{
+		return _open(path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+	}
+
+	static void CloseFile(int fd)
+	{
+		_close(fd);
+	}
+
+	static bool WriteAll(int fd, const void* data, size_t size)
+	{
+		const char* bytes = static_cast<const char*>(data);
+		while (size > 0)
+		{
+			int written = _write(fd, bytes, static_cast<unsigned int>(size));
+			if (written <= 0)
+			{
+				return false;
+			}
+			bytes += written;
+			size -= written;
+		}
+		return true;
+	}
+
+	static bool SyncFile(int fd)
+	{
+		return _commit(fd) == 0;
+	}
+
+	static bool TruncateFile(int fd, long long size)
+	{
+		return _chsize_s(fd, size) == 0;
+	}
+#else
+	static int OpenFile(const char* path)
+	{
+		return open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+	}
+
+	static void CloseFile(int fd)
+	{
+		close(fd);
+	}
+
+	static bool WriteAll(int fd, const void* data, size_t size)
+	{
+		const char* bytes = static_cast<const char*>(data);
+		while (size > 0)
+		{
+			ssize_t written = write(fd, bytes, size);
+			if (written <= 0)
+			{
+				return false;
+			}
+			bytes += written;
+			size -= static_cast<size_t>(written);
+		}
+		return true;
+	}
+
+	static bool SyncFile(int fd)
+	{
+#if defined(__linux__)
+		return fdatasync(fd) == 0;
+#else
+		return fsync(fd) == 0;
+#endif
+	}
+
+	static bool TruncateFile(int fd, long long size)
+	{
+		return ftruncate(fd, static_cast<off_t>(size)) == 0;
+	}
+#endif
+
+private:
+	JournalOptions options_;
+	TTree tree_;
+
+	std::string snapshot_path_;
+	std::string journal_path_;
+	int fd_ = -1;
+	int replayed_num_ = 0;
+	// ǰļĴ־ͷм¼ֵͬ
+	uint64_t generation_ = 0;
+
+	// λ޸߳appended_num_׷ӣ̨߳д[flushed_num_, appended_num_)ƽflushed_num_֮С
+	std::vector<RecordType> ring_;
+	std::atomic<uint64_t> appended_num_{ 0 };
+	std::atomic<uint64_t> flushed_num_{ 0 };
+
+	// mutex_µļͱ־io_mutex_־ļдͽض
+	std::mutex mutex_;
+	std::mutex io_mutex_;
+	std::condition_variable flush_cv_;
+	std::condition_variable durable_cv_;
+	std::thread flusher_;
+	uint64_t durable_num_ = 0;
+	bool stop_ = false;
+	bool sync_requested_ = false;
+	bool failed_ = false;
+};
+
+#endif // !TREE_JOURNAL_H_
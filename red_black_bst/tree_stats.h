@@ -0,0 +1,62 @@
+#ifndef TREE_STATS_H_
+#define TREE_STATS_H_
+
+#include <cstdint>
+
+// ·ϵļʱRED_BLACK_BST_STATSſ
+// ̱߳thread_localУۼʱҪԭӲͼ
+// δʱTREE_STATS_INCչΪ䣬κδ
+struct TreeStats
+{
+	uint64_t rotate_left = 0;
+	uint64_t rotate_right = 0;
+	uint64_t flip_color = 0;
+	uint64_t move_red_left = 0;
+	uint64_t move_red_right = 0;
+	uint64_t balance = 0;
+	// PutGetڲ·ϱȽϹĽڵ
+	uint64_t put_compare = 0;
+	uint64_t get_compare = 0;
+	uint64_t node_alloc = 0;
+	uint64_t node_free = 0;
+
+	TreeStats& operator+=(const TreeStats& other)noexcept
+	{
+		rotate_left += other.rotate_left;
+		rotate_right += other.rotate_right;
+		flip_color += other.flip_color;
+		move_red_left += other.move_red_left;
+		move_red_right += other.move_red_right;
+		balance += other.balance;
+		put_compare += other.put_compare;
+		get_compare += other.get_compare;
+		node_alloc += other.node_alloc;
+		node_free += other.node_free;
+		return *this;
+	}
+};
+
+// ǰ̵߳ļδʱʼΪ0
+inline TreeStats& ThreadTreeStats()noexcept
+{
+	static thread_local TreeStats stats;
+	return stats;
+}
+
+#if defined(RED_BLACK_BST_STATS)
+const bool kTreeStatsEnabled = true;
+#define TREE_STATS_INC(field) (++ThreadTreeStats().field)
+#else
+const bool kTreeStatsEnabled = false;
+#define TREE_STATS_INC(field) ((void)0)
+#endif // RED_BLACK_BST_STATS
+
+// ȡǰ̵߳ļ㣬߳̽ǰȡɵ÷
+inline TreeStats TakeThreadTreeStats()noexcept
+{
+	TreeStats stats = ThreadTreeStats();
+	ThreadTreeStats() = TreeStats();
+	return stats;
+}
+
+#endif // !TREE_STATS_H_